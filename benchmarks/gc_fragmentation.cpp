@@ -0,0 +1,111 @@
+// gc_fragmentation.cpp — page memory held by druk::gc::GcHeap under churn of varying object
+// sizes, with and without compaction
+//
+// Usage: druk_gc_fragmentation [rounds] [compact-percent]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "druk/codegen/core/value.h"
+#include "druk/gc/gc_heap.h"
+#include "druk/gc/types/gc_array.h"
+#include "druk/gc/types/gc_string.h"
+
+
+using druk::codegen::Value;
+using namespace druk::gc;
+
+namespace
+{
+
+constexpr size_t kPerRound = 50'000;
+
+// Long-lived objects. Registered with an update function, so a compaction may move them.
+std::vector<Value> g_survivors;
+
+void report(const char* when, size_t round)
+{
+    GcStats stats = GcHeap::get().stats();
+    std::printf("%-14s %6zu %12.2f %12.2f %8zu%%\n", when, round,
+                static_cast<double>(stats.liveBytes) / 1e6,
+                static_cast<double>(stats.committedBytes) / 1e6, GcHeap::get().fragmentation());
+}
+
+// Strings and arrays of every size class die at different times: most immediately, a few
+// after some rounds, so old pages keep a scattering of survivors.
+void churn(std::mt19937& rng)
+{
+    auto&                                 heap = GcHeap::get();
+    std::uniform_int_distribution<size_t> length(0, 200);
+    std::uniform_int_distribution<size_t> elements(0, 12);
+    std::uniform_int_distribution<int>    keep(0, 49);
+    std::string                           text(200, 'x');
+    for (size_t i = 0; i < kPerRound; ++i)
+    {
+        Value value;
+        if (i % 2)
+            value = Value(heap.allocString(std::string_view(text).substr(0, length(rng))));
+        else
+        {
+            auto* arr = heap.alloc<GcArray>();
+            for (size_t e = elements(rng); e > 0; --e) arr->elements.push_back(Value(int64_t{1}));
+            heap.notifyGrowth(arr, payloadBytes(arr));
+            value = Value(arr);
+        }
+        if (keep(rng) == 0)
+            g_survivors.push_back(value);
+    }
+
+    // Half of the survivors die at random.
+    std::shuffle(g_survivors.begin(), g_survivors.end(), rng);
+    g_survivors.resize(g_survivors.size() / 2);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    size_t rounds = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+
+    auto& heap = GcHeap::get();
+    heap.setCompactThreshold(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0);
+    auto roots = heap.roots().addCallback(
+        [](void*)
+        {
+            for (const auto& value : g_survivors) value.markGcRefs();
+        },
+        nullptr,
+        [](void*)
+        {
+            for (auto& value : g_survivors) value.updateGcRefs();
+        });
+
+    std::mt19937 rng(42);
+    std::printf("%-14s %6s %12s %12s %9s\n", "", "round", "live MB", "pages MB", "spare");
+    for (size_t round = 1; round <= rounds; ++round)
+    {
+        churn(rng);
+        heap.safepoint();  // every reference the benchmark holds is in g_survivors
+        if (round % (rounds < 10 ? 1 : rounds / 10) == 0)
+            report("churn", round);
+    }
+
+    heap.collect();
+    report("full GC", rounds);
+    auto start = std::chrono::steady_clock::now();
+    heap.compact();
+    double ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    report("compacted", rounds);
+    GcStats stats = heap.stats();
+    std::printf("compactions: %zu, moved %zu objects; last one took %.2f ms\n", stats.compactions,
+                stats.objectsMoved, ms);
+
+    g_survivors.clear();
+    heap.collect();
+    return 0;
+}
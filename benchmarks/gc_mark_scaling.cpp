@@ -0,0 +1,94 @@
+// gc_mark_scaling.cpp — full-collection pause of druk::gc::GcHeap against mark thread count
+//
+// Usage: druk_gc_mark_scaling [objects] [max-threads]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "druk/codegen/core/value.h"
+#include "druk/gc/gc_heap.h"
+#include "druk/gc/types/gc_array.h"
+#include "druk/gc/types/gc_string.h"
+#include "druk/gc/types/gc_struct.h"
+
+
+using druk::codegen::Value;
+using namespace druk::gc;
+
+namespace
+{
+
+std::vector<GcObject*> g_roots;
+
+// A forest of small trees: a root array of structs, each holding an array of strings. Every
+// object survives, so each collection marks the whole graph.
+void buildGraph(size_t objects)
+{
+    auto& heap = GcHeap::get();
+    auto* top  = heap.alloc<GcArray>();
+    g_roots.push_back(top);
+    for (size_t made = 1; made < objects; made += 10)
+    {
+        auto* node = heap.alloc<GcStruct>();
+        top->elements.push_back(Value(node));
+        heap.writeBarrier(top, node);
+
+        auto* leaves = heap.alloc<GcArray>();
+        node->set("kids", Value(leaves));
+        heap.writeBarrier(node, leaves);
+        for (int i = 0; i < 8; ++i)
+        {
+            auto* s = heap.allocString("leaf");
+            leaves->elements.push_back(Value(s));
+            heap.writeBarrier(leaves, s);
+        }
+    }
+}
+
+double timeCollect()
+{
+    auto start = std::chrono::steady_clock::now();
+    GcHeap::get().collect();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    size_t n          = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    size_t maxThreads = argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+                                 : std::max<size_t>(1, std::thread::hardware_concurrency());
+
+    auto& heap = GcHeap::get();
+    auto roots = heap.roots().addCallback(
+        [](void*)
+        {
+            for (auto* obj : g_roots) GcHeap::get().markObject(obj);
+        },
+        nullptr);
+    buildGraph(n);
+    heap.collect();  // promote everything so each timed run is a steady-state full mark
+
+    std::printf("%8s %12s %10s\n", "threads", "pause ms", "speedup");
+    double serial = 0;
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        heap.setMarkThreads(threads);
+        double best = timeCollect();
+        for (int run = 0; run < 4; ++run) best = std::min(best, timeCollect());
+        if (threads == 1)
+            serial = best;
+        std::printf("%8zu %12.2f %9.2fx\n", threads, best, serial / best);
+    }
+
+    g_roots.clear();
+    heap.setMarkThreads(1);
+    heap.collect();
+    return 0;
+}
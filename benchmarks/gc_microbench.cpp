@@ -0,0 +1,154 @@
+// gc_microbench.cpp — allocation / collection throughput of druk::gc::GcHeap
+//
+// Usage: druk_gc_microbench [iterations] [pause-budget-us]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "druk/codegen/core/value.h"
+#include "druk/gc/gc_heap.h"
+#include "druk/gc/types/gc_array.h"
+#include "druk/gc/types/gc_string.h"
+#include "druk/gc/types/gc_struct.h"
+
+
+using druk::codegen::Value;
+using namespace druk::gc;
+
+namespace
+{
+
+std::vector<GcObject*> g_roots;
+
+template <typename Fn>
+void run(const char* name, size_t allocations, Fn&& body)
+{
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() -
+                                                            start)
+                       .count();
+    std::printf("%-22s %10zu allocs %10.2f ms %8.2f ns/alloc %8zu live\n", name, allocations,
+                elapsed / 1e6, elapsed / static_cast<double>(allocations),
+                GcHeap::get().objectCount());
+    g_roots.clear();
+    GcHeap::get().collect();
+}
+
+// Builds a rooted object graph, then times one full collection that has to mark all of it.
+template <typename Fn>
+void runMark(const char* name, size_t objects, Fn&& build)
+{
+    build();
+    auto start = std::chrono::steady_clock::now();
+    GcHeap::get().collect();
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() -
+                                                            start)
+                       .count();
+    std::printf("%-22s %10zu objects %9.2f ms %8.2f ns/object\n", name, objects, elapsed / 1e6,
+                elapsed / static_cast<double>(objects));
+    g_roots.clear();
+    GcHeap::get().collect();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+
+    auto&          heap = GcHeap::get();
+    GcMutatorScope mutator;  // as the VM and JIT run scripts
+    if (argc > 2)
+        heap.setPauseBudget(std::strtoull(argv[2], nullptr, 10));
+    std::printf("slot bytes: string %zu, array %zu, struct %zu\n",
+                kSizeClasses[sizeClassOf(sizeof(GcString))],
+                kSizeClasses[sizeClassOf(sizeof(GcArray))],
+                kSizeClasses[sizeClassOf(sizeof(GcStruct))]);
+    auto roots = heap.roots().addCallback(
+        [](void*)
+        {
+            for (auto* obj : g_roots) GcHeap::get().markObject(obj);
+        },
+        nullptr);
+
+    // Short-lived temporaries, like interpolated strings: everything dies young.
+    run("string churn", n,
+        [&]
+        {
+            for (size_t i = 0; i < n; ++i) heap.allocString("tmp");
+        });
+
+    // One in a hundred strings is stored into a long-lived array.
+    run("string retain 1%", n,
+        [&]
+        {
+            auto* keep = heap.alloc<GcArray>();
+            g_roots.push_back(keep);
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto* s = heap.allocString(std::to_string(i));
+                if (i % 100 == 0)
+                {
+                    keep->elements.push_back(Value(s));
+                    heap.writeBarrier(keep, s);
+                }
+            }
+        });
+
+    // Mixed size classes: small arrays and structs holding strings.
+    run("mixed arrays/structs", n,
+        [&]
+        {
+            for (size_t i = 0; i < n / 3; ++i)
+            {
+                // Each new object is reachable before the next allocation can collect.
+                auto* obj = heap.alloc<GcStruct>();
+                g_roots.push_back(obj);
+                auto* arr = heap.alloc<GcArray>();
+                obj->set("x", Value(arr));
+                heap.writeBarrier(obj, arr);
+                auto* str = heap.allocString("field");
+                arr->elements.push_back(Value(str));
+                heap.writeBarrier(arr, str);
+                g_roots.pop_back();
+            }
+        });
+
+    // Marking: a linked chain of arrays (deep) and one array of strings (wide). The chain is
+    // deep enough to overflow the native stack with recursive tracing.
+    size_t graph = n / 2;
+    runMark("mark deep chain", graph,
+            [&]
+            {
+                auto* head = heap.alloc<GcArray>();
+                g_roots.push_back(head);
+                for (size_t i = 1; i < graph; ++i)
+                {
+                    auto* next = heap.alloc<GcArray>();
+                    head->elements.push_back(Value(next));
+                    heap.writeBarrier(head, next);
+                    head = next;
+                }
+            });
+    runMark("mark wide array", graph,
+            [&]
+            {
+                auto* wide = heap.alloc<GcArray>();
+                g_roots.push_back(wide);
+                wide->elements.reserve(graph);
+                for (size_t i = 1; i < graph; ++i)
+                {
+                    auto* s = heap.allocString("leaf");
+                    wide->elements.push_back(Value(s));
+                    heap.writeBarrier(wide, s);
+                }
+            });
+
+    // Pauses taken by allocation-triggered collections across every workload above.
+    heap.pauses().print(std::cout);
+    return 0;
+}
@@ -6,6 +6,11 @@
 #include "druk/codegen/core/opcode.h"
 #include "druk/codegen/core/value.h"
 
+namespace druk::gc
+{
+class GcShape;
+}
+
 namespace druk::codegen
 {
 
@@ -23,6 +28,10 @@ class Chunk
     {
         return constants_;
     }
+    std::vector<Value>& constants()
+    {
+        return constants_;
+    }
 
     const std::vector<uint8_t>& code() const
     {
@@ -39,6 +48,32 @@ class Chunk
         return code_[offset];
     }
 
+    // Numbers every global name the code refers to (see globalSlot). Called once the chunk is
+    // complete and before it runs, so the interpreter, on any thread, only reads the slots.
+    void resolveGlobals();
+
+    // The global slot named by string constant `index`, or kUnresolvedSlot if no global
+    // instruction named it when the chunk was resolved.
+    static constexpr uint32_t kUnresolvedSlot = UINT32_MAX;
+    uint32_t                  globalSlotAt(size_t index) const
+    {
+        return index < globalSlots_.size() ? globalSlots_[index] : kUnresolvedSlot;
+    }
+
+    // The inline cache of the field named by string constant `index`, shared by the chunk's
+    // instructions that access that field: the last struct shape seen and its slot for the field.
+    struct FieldCache
+    {
+        const gc::GcShape* shape = nullptr;
+        uint32_t           slot  = 0;
+    };
+    FieldCache& fieldCacheAt(size_t index)
+    {
+        if (fieldCaches_.size() <= index)
+            fieldCaches_.resize(index + 1);
+        return fieldCaches_[index];
+    }
+
     // Storage for string constants (for deserialization)
     std::vector<std::string>& stringStorage()
     {
@@ -54,6 +89,8 @@ class Chunk
     std::vector<int>         lines_;
     std::vector<Value>       constants_;
     std::vector<std::string> stringStorage_;  // Owns string data for deserialization
+    std::vector<uint32_t>    globalSlots_;    // by constant index
+    std::vector<FieldCache>  fieldCaches_;    // by constant index
 };
 
 }  // namespace druk::codegen
@@ -64,6 +64,12 @@ class CodeGenerator : public parser::ast::Visitor
     void visit(parser::ast::Expr* expr);
     void visit(parser::ast::Type* type);
 
+    // Static typing: seeds local slots from semantic types and verifies them against the IR.
+    std::shared_ptr<ir::Type> lowerType(const semantic::Type& type) const;
+    void                      refineLocalTypes(ir::Function* func);
+    // The runtime shape a struct of this type is built with: its fields, in order.
+    const gc::GcShape*        lowerShape(const semantic::Type& type) const;
+
     ir::Module&         module_;
     ir::IRBuilder       builder_;
     util::ErrorHandler& errors_;
@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+namespace druk::codegen
+{
+
+// Process-wide numbering of global variable names. A name keeps its slot for the life of the
+// process, so code resolves it once and from then on indexes a flat array of globals; every VM
+// and the JIT runtime number their globals the same way.
+uint32_t globalSlot(std::string_view name);
+
+}  // namespace druk::codegen
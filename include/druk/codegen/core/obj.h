@@ -14,11 +14,9 @@ struct ObjFunction : public gc::GcObject
     Chunk       chunk;
     std::string name;
     int         arity = 0;
+    void*       code  = nullptr;  // JIT entry point (DrukJitFunc) once compiled
 
     ObjFunction() : gc::GcObject(gc::GcType::Function) {}
-    ~ObjFunction() override = default;
-
-    void trace() override;
 };
 
 }  // namespace druk::codegen
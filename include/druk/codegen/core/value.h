@@ -9,6 +9,7 @@ namespace druk
 namespace gc
 {
 class GcArray;
+class GcObject;
 class GcString;
 class GcStruct;
 class GcHeap;
@@ -45,9 +46,11 @@ class Value
     {
         data_.i = v;
     }
+    // The whole payload is written: compiled code copies values as raw bytes and tests a bool's
+    // payload as an int64, like PackedValue's.
     explicit Value(bool v) : type_(ValueType::Bool)
     {
-        data_.b = v;
+        data_.i = v ? 1 : 0;
     }
     explicit Value(gc::GcString* v);
     explicit Value(gc::GcArray* v);
@@ -143,7 +146,11 @@ class Value
         return !(*this == other);
     }
 
-    void markGcRefs() const;
+    // Heap object referenced by this value, or nullptr for immediates.
+    [[nodiscard]] gc::GcObject* gcRef() const;
+    void                        markGcRefs() const;
+    // Follows the object this value references to where a running compaction moved it.
+    void                        updateGcRefs();
 
    private:
     ValueType type_;
@@ -9,6 +9,8 @@ struct ObjFunction;
 
 extern "C"
 {
+    // Same 16-byte layout as codegen::Value: a tag byte followed by an 8-byte payload, so a value
+    // moves in two registers. Bools are stored widened to the full payload (0 or 1).
     struct PackedValue
     {
         uint8_t type;
@@ -20,22 +22,79 @@ extern "C"
             const char* s;
             void*       ptr;
         } data;
-        int64_t extra;
     };
+    static_assert(sizeof(PackedValue) == 16, "PackedValue must stay two machine words");
 
     using DrukJitFunc      = void (*)(PackedValue* out);
     using DrukJitCompileFn = DrukJitFunc (*)(druk::codegen::ObjFunction* function);
 
+    // A dynamic call site's inline cache: the entry points it has called with the right number
+    // of arguments, each with the body that takes them in registers. Compiled code calls a body
+    // directly when the callee matches; an entry never changes once `entry` is set. `entry` is
+    // published with a release store after `impl`, and compiled code loads it with acquire.
+    struct DrukCallCacheEntry
+    {
+        void* entry;
+        void* impl;
+    };
+    constexpr int32_t kDrukCallCacheSize = 4;
+    struct DrukCallCache
+    {
+        DrukCallCacheEntry entries[kDrukCallCacheSize];
+    };
+
+    // A struct field access site's inline cache: the struct shapes it has seen with the field,
+    // each with the slot that holds it. Compiled code reads the slot directly when a struct's
+    // shape matches; an entry never changes once `shape` is set. `shape` is published with a
+    // release store after `slot`, and compiled code loads it with acquire.
+    struct DrukFieldCacheEntry
+    {
+        const void* shape;
+        int64_t     slot;
+    };
+    constexpr int32_t kDrukFieldCacheSize = 4;
+    struct DrukFieldCache
+    {
+        DrukFieldCacheEntry entries[kDrukFieldCacheSize];
+    };
+
     void    druk_jit_set_args(const char** argv, int32_t argc);
     void    druk_jit_register_function(druk::codegen::ObjFunction* function, DrukJitFunc fn);
     void    druk_jit_set_compile_handler(DrukJitCompileFn fn);
     void    druk_jit_call(const PackedValue* callee, const PackedValue* args, int32_t arg_count,
                           PackedValue* out);
     void    druk_jit_get_arg(int32_t index, PackedValue* out);
+    void    druk_jit_register_native(void* entry, void* impl, int32_t arity);
+    void    druk_jit_call_cached(DrukCallCache* cache, const PackedValue* callee,
+                                 const PackedValue* args, int32_t arg_count, PackedValue* out);
+    void    druk_jit_new_struct(const void* shape, const PackedValue* values, PackedValue* out);
+    void    druk_jit_get_field_cached(DrukFieldCache* cache, const PackedValue* struct_val,
+                                      const char* field, size_t field_len, PackedValue* out);
+    void    druk_jit_set_field_cached(DrukFieldCache* cache, PackedValue* struct_val,
+                                      const char* field, size_t field_len, const PackedValue* val);
     int64_t druk_jit_value_as_int(const PackedValue* value);
     int32_t druk_jit_value_as_bool_int(const PackedValue* value);
     void    druk_jit_string_literal(const char* data, size_t len, PackedValue* out);
     void    druk_jit_value_raw_function(void* ptr, PackedValue* out);
     void    druk_jit_panic_unwrap();
 
+    // Shadow stack of JIT frame roots; every compiled function pushes its zeroed PackedValue
+    // slots on entry and pops them before returning.
+    void druk_jit_push_roots(PackedValue* slots, int32_t count);
+    void druk_jit_pop_roots();
+
+    // Allocation sites for --heap-profile: the backend registers one per source line while
+    // compiling and makes it current before that line's instructions run.
+    uint32_t druk_jit_register_alloc_site(const char* function, uint32_t line);
+    void     druk_jit_set_alloc_site(uint32_t site);
+
+    // The calling thread's gc::GcAllocationBuffer, which compiled code bumps to allocate small
+    // arrays, strings and structs inline; it calls into the runtime only when the buffer runs dry.
+    void* druk_jit_alloc_buffer();
+
+    // Stops for another thread's collection or runs a pending compaction. Compiled code polls
+    // GcHeap::safepointRequested() at function entries and loop back-edges and calls this when
+    // it is set.
+    void druk_jit_safepoint();
+
 }  // extern "C"
@@ -17,6 +17,7 @@
 #include "druk/codegen/core/obj.h"
 #include "druk/codegen/core/value.h"
 #include "druk/codegen/jit/jit_runtime.h"
+#include "druk/gc/gc_object.h"
 #include "druk/ir/ir_function.h"
 
 namespace druk::codegen
@@ -36,7 +37,12 @@ class LLVMBackend
     bool         emitObjectFile(ir::Module& module, const std::string& obj_path);
 
    private:
-    bool debug_ = false;
+    bool debug_           = false;
+    bool profile_sites_   = false;  // JIT code for --heap-profile tags allocations with sites
+    bool inline_alloc_    = false;  // JIT code bumps small objects off the thread's buffer
+    bool call_caches_     = false;  // JIT dynamic calls check a per-site inline cache first
+    bool inline_shapes_   = false;  // JIT code embeds struct shapes and reads cached fields inline
+    bool safepoint_polls_ = false;  // JIT code stops for other threads' collections
 
     struct CompilationContext
     {
@@ -47,23 +53,52 @@ class LLVMBackend
 
         ir::Function*   current_ir_function = nullptr;
         llvm::Function* llvm_function       = nullptr;
-        llvm::Value*    ret_out             = nullptr;
+        llvm::Value*    alloc_buffer        = nullptr;  // gc::GcAllocationBuffer*, per function
 
         // New IR State
         std::unordered_map<ir::Value*, llvm::Value*>           ir_values;
+        std::unordered_map<ir::Value*, llvm::Value*>           ir_scalars;  // unboxed i64 / i1
         std::unordered_map<ir::BasicBlock*, llvm::BasicBlock*> ir_blocks;
         std::unordered_map<ir::Function*, llvm::Function*>     ir_functions;  // implementations
         std::unordered_map<ir::Function*, llvm::Function*>     ir_wrappers;   // void(out*) thunks
 
         std::unordered_map<std::string, llvm::GlobalVariable*> globals;
+        // Immortal GcString images of the module's string constants, one per distinct text
+        std::unordered_map<std::string, llvm::GlobalVariable*> string_literals;
 
         CompilationContext();
     };
 
     std::unique_ptr<CompilationContext> ctx_;
 
-    llvm::Value* get_llvm_value(ir::Value* value);
-    llvm::Value* create_entry_alloca(llvm::Type* type, const std::string& name = "");
+    llvm::Value*      get_llvm_value(ir::Value* value);
+    llvm::Value*      create_entry_alloca(llvm::Type* type, const std::string& name = "");
+    llvm::StructType* get_packed_value_type();
+
+    // Static calls pass and return values in registers as {i8 tag, i64 payload} pairs; only
+    // the void(out*) wrappers for dynamic entry go through memory (backend_ir_native_call.cpp)
+    llvm::StructType*   get_value_pair_type();
+    llvm::FunctionType* get_impl_type(size_t param_count);
+    llvm::Value*        make_value_pair(llvm::Value* tag, llvm::Value* payload);
+    llvm::Value*        load_value_pair(llvm::Value* packed);
+    llvm::Value*        get_value_pair(ir::Value* value);
+    void                store_value_pair(llvm::Value* pair, llvm::Value* packed);
+    void                copy_value_pair(llvm::Value* from, llvm::Value* to);
+
+    // Folds the PackedValue allocas of a finished function into one frame registered on the
+    // runtime shadow stack, making its locals precise GC roots (backend_ir_gc_roots.cpp)
+    void emit_gc_root_frame(llvm::Function* fn);
+
+    // Safepoint polls on function entries and loop back-edges, so a thread running compiled
+    // code stops for collections on other threads, as the VM does (backend_ir_safepoint.cpp)
+    void              emit_safepoint_poll(llvm::IRBuilder<>& builder, llvm::BasicBlock* next);
+    llvm::BasicBlock* branch_target(ir::BasicBlock* dest);
+
+    // Unboxed lowering of statically int/bool IR values (backend_ir_unboxed.cpp)
+    llvm::Type*  get_scalar_type(const ir::Type& type);
+    llvm::Value* get_scalar_value(ir::Value* value);
+    llvm::Value* box_scalar(llvm::Value* scalar, ir::TypeID type);
+    bool         compile_unboxed_op(ir::Instruction* inst);
 
     void compile_instruction(ir::Instruction* inst, llvm::StructType* packed_value_ty,
                              llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty);
@@ -72,10 +107,23 @@ class LLVMBackend
 
     void compile_single_function(ir::Function* function, llvm::StructType* packed_value_ty,
                                  llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty);
+    void emit_alloc_site(ir::Function* function, uint32_t line);
     void compile_binary_op(ir::Instruction* inst, llvm::StructType* packed_value_ty,
                            llvm::PointerType* packed_ptr_ty);
-    void compile_memory_ops(ir::Instruction* inst, llvm::StructType* packed_value_ty,
-                            llvm::Type* i64_ty);
+    bool emit_int_fast_path(ir::Opcode op, llvm::Value* lhs, llvm::Value* rhs, llvm::Value* res,
+                            llvm::StructType*          packed_value_ty,
+                            llvm::function_ref<void()> emit_slow_path);
+
+    // Allocates an object of `bytes` inline from the thread's allocation buffer, writes its
+    // header, lets `emit_init` fill in the rest and stores it to `res`; falls back to
+    // `emit_slow_path` when the buffer is dry. False if the object cannot be allocated inline
+    // (backend_ir_inline_alloc.cpp).
+    llvm::Value* get_alloc_buffer();
+    bool         emit_inline_alloc(size_t bytes, gc::GcType kind, llvm::Value* res,
+                                   llvm::StructType*                      packed_value_ty,
+                                   llvm::function_ref<void(llvm::Value*)> emit_init,
+                                   llvm::function_ref<void()>             emit_slow_path);
+    void compile_memory_ops(ir::Instruction* inst, llvm::StructType* packed_value_ty);
     void compile_array_ops(ir::Instruction* inst, llvm::StructType* packed_value_ty,
                            llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty);
     void compile_array_build(ir::Instruction* inst, llvm::StructType* packed_value_ty,
@@ -84,6 +132,12 @@ class LLVMBackend
                              llvm::PointerType* packed_ptr_ty);
     void compile_array_len(ir::Instruction* inst, llvm::StructType* packed_value_ty,
                            llvm::PointerType* packed_ptr_ty);
+    void compile_struct_ops(ir::Instruction* inst, llvm::StructType* packed_value_ty,
+                            llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty);
+    void compile_struct_build(ir::Instruction* inst, llvm::StructType* packed_value_ty,
+                              llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty);
+    void compile_field_access(ir::Instruction* inst, llvm::StructType* packed_value_ty,
+                              llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty);
     void compile_control_flow(ir::Instruction* inst, llvm::StructType* packed_value_ty,
                               llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty);
     void compile_call_op(ir::Instruction* inst, llvm::PointerType* packed_ptr_ty);
@@ -1,11 +1,44 @@
 #pragma once
+#include <array>
 #include <cstddef>
 
 namespace druk::gc
 {
 
-inline constexpr size_t kInitialThreshold = 64;
-inline constexpr size_t kGrowthFactor     = 2;
-inline constexpr size_t kMinThreshold     = 32;
+// Pacing: a full collection runs once the old generation has grown by this percentage of the
+// bytes that survived the previous one (override with DRUK_GC_GROWTH or --gc-growth=<percent>),
+// but never below kMinHeapBytes.
+inline constexpr size_t kDefaultGrowthPercent = 100;
+inline constexpr size_t kMinHeapBytes         = 4 * 1024 * 1024;
+
+// Objects live in kPageSize pages (aligned to their own size) holding one size class each.
+inline constexpr size_t                kPageSize    = 64 * 1024;
+inline constexpr std::array<size_t, 9> kSizeClasses = {32, 40, 48, 64, 80, 96, 128, 192, 256};
+
+// A minor collection runs once this many bytes (slots plus payloads) were allocated since the
+// last collection.
+inline constexpr size_t kNurseryBytes = 1024 * 1024;
+
+// A thread inside a GcMutatorScope allocates from pages of its own and visits the shared heap
+// (taking its lock, checking the collection triggers) once per this many bytes.
+inline constexpr size_t kMutatorBudgetBytes = 32 * 1024;
+
+// Full collections mark with this many threads (override with DRUK_GC_THREADS or
+// --gc-threads=<n>; 0 picks one per hardware thread).
+inline constexpr size_t kDefaultMarkThreads = 1;
+
+// With a non-zero pause budget (DRUK_GC_PAUSE_US or --gc-pause=<us>) full collections mark
+// incrementally: one step of at most the budget runs per kMarkStepBytes allocated.
+inline constexpr size_t kDefaultPauseBudgetUs = 0;
+inline constexpr size_t kMarkStepBytes        = 256 * 1024;
+
+// Full collections leave dead objects for the allocator to sweep page by page. A background
+// thread can sweep the rest concurrently (DRUK_GC_BACKGROUND_SWEEP=1 or --gc-background-sweep).
+inline constexpr bool kDefaultBackgroundSweep = false;
+
+// With a non-zero threshold (DRUK_GC_COMPACT or --gc-compact=<percent>), a full collection after
+// which compacting would release more than this percentage of the small-object pages schedules
+// a compaction; it runs at the mutator's next safepoint.
+inline constexpr size_t kDefaultCompactPercent = 0;
 
 }  // namespace druk::gc
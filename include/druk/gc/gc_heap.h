@@ -1,15 +1,35 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "druk/gc/gc_config.h"
+#include "druk/gc/gc_mutator.h"
 #include "druk/gc/gc_object.h"
+#include "druk/gc/gc_page.h"
+#include "druk/gc/gc_pause.h"
+#include "druk/gc/gc_profile.h"
 #include "druk/gc/gc_roots.h"
+#include "druk/gc/gc_stats.h"
+#include "druk/gc/types/gc_string.h"
 
 
 namespace druk::gc
 {
 
+// One heap per process, shared by every thread. Threads that run Druk code concurrently each
+// do so inside a GcMutatorScope (gc_mutator.h).
 class GcHeap
 {
    public:
@@ -18,29 +38,261 @@ class GcHeap
     template <typename T, typename... Args>
     T* alloc(Args&&... args)
     {
-        maybeCollect();
-        auto* obj = new T(std::forward<Args>(args)...);
-        obj->next = head_;
-        head_     = obj;
-        ++count_;
+        static_assert(!std::is_same_v<T, GcString>, "strings are sized at run time: allocString");
+        constexpr size_t sizeClass = sizeClassOf(sizeof(T));
+        static_assert(sizeClass < kSizeClasses.size(), "GcObject larger than every size class");
+
+        if (!running_)
+        {
+            // Outside a scope the allocation runs as a brief one, so a collection on another
+            // thread never meets the slot before the object in it is constructed.
+            GcMutatorScope scope;
+            return alloc<T>(std::forward<Args>(args)...);
+        }
+        auto* obj  = new (allocateSlot(sizeClass)) T(std::forward<Args>(args)...);
+        obj->young = true;
+        if (size_t payload = payloadBytes(obj))
+            notifyGrowth(obj, payload);
+        if (profileInterval_)
+            profile_.record(obj);
         return obj;
     }
 
-    void       collect();
-    void       markObject(GcObject* obj);
-    GcRootSet& roots();
-    size_t     objectCount() const;
+    // Allocates `left` followed by `right` as one string. Both views must stay valid across a
+    // collection, so they may not point into an unrooted GcString.
+    GcString* allocString(std::string_view left, std::string_view right = {})
+    {
+        size_t length = left.size() + right.size();
+        if (length > UINT32_MAX)
+            throw std::length_error("string too long");
+        if (!running_)
+        {
+            GcMutatorScope scope;
+            return allocString(left, right);
+        }
+        size_t bytes     = GcString::allocationSize(length);
+        size_t sizeClass = sizeClassOf(bytes);
+        void*  mem = sizeClass < kSizeClasses.size() ? allocateSlot(sizeClass)
+                                                     : allocateSlow(sizeClass, bytes);
+        auto*  str = new (mem) GcString(left, right);
+        str->young = true;
+        if (profileInterval_)
+            profile_.record(str);
+        return str;
+    }
+
+    // Reports payload bytes an object gained after allocation (e.g. an array push), so large
+    // containers drive pacing as much as many small objects do.
+    void notifyGrowth(const GcObject* owner, size_t bytes)
+    {
+        GcMutator* self = running_;
+        if (self && self->buffer.budget >= bytes)
+        {
+            self->buffer.budget -= bytes;
+            if (!owner->young)
+                self->oldGrowth += bytes;
+            return;
+        }
+        notifyGrowthSlow(owner, bytes);
+    }
+
+    // Must follow every store of a reference to `child` into `owner`. An old object that gains
+    // a pointer to a young one is remembered and rescanned by the next minor collection. While
+    // an incremental cycle is marking, the child is shaded so no traced object hides it.
+    void writeBarrier(GcObject* owner, GcObject* child)
+    {
+        if (!child)
+            return;
+        if (child->young && !owner->young && !owner->remembered)
+            remember(owner);
+        if (marking_.load(std::memory_order_relaxed))
+            shade(child);
+    }
+
+    // The calling thread's allocation buffer, for compiled code that allocates inline: while the
+    // thread runs inside a GcMutatorScope, objects bumped off a run with room, within the
+    // budget, are allocated once their header is written (see GcObjectLayout). Outside a scope
+    // the budget is zero.
+    GcAllocationBuffer& allocationBuffer();
+
+    void              collect();
+    void              collectMinor();
+    // A full collection that then slides the survivors of each fragmented size class into as
+    // few pages as possible and releases the rest. References in heap objects, function
+    // constants and the root set are updated; raw pointers held anywhere else are not, so only
+    // call it where the mutator keeps every reference in its roots.
+    void              compact();
+    // Stops here while another thread collects, then runs the compaction a full collection
+    // asked for, if any. Mutators call this where they hold no references outside their roots
+    // (the VM does on calls and loop back-edges).
+    void              safepoint()
+    {
+        if (safepointRequested_.load(std::memory_order_acquire))
+            safepointSlow();
+    }
+    // Set while safepoint() has something to do, for compiled code that tests it inline and only
+    // calls safepoint() when it is.
+    const std::atomic<bool>& safepointRequested() const { return safepointRequested_; }
+    // During a compaction, where `obj` moved to; any other object is returned as is.
+    GcObject*         forwarded(GcObject* obj) const;
+    // A view of a whole string that a compaction moved, rebased onto its new bytes.
+    std::string_view  forwarded(std::string_view chars) const;
+    // Runs one budgeted step of incremental marking, starting a cycle if none is running and
+    // finishing it with a full collection once marking runs dry.
+    void              markIncrement();
+    void              markObject(GcObject* obj);
+    bool              marking() const;
+    GcRootSet&        roots();
+    GcPauseHistogram& pauses();
+    // Finishes any pending sweep, then takes a census of the live objects.
+    GcStats           stats();
+    size_t            objectCount() const;
+    size_t            heapBytes() const;
+    void              setGrowthPercent(size_t percent);
+    void              setMarkThreads(size_t threads);
+    void              setPauseBudget(size_t micros);
+    void              setBackgroundSweep(bool enabled);
+    void              setStatsLevel(GcStatsLevel level);
+    // Percentage of releasable small-object pages (see GcPageSpace::fragmentation) above which
+    // a full collection schedules a compaction; 0 never compacts on its own.
+    void              setCompactThreshold(size_t percent);
+    size_t            fragmentation() const;
+    // Records allocation sites and prints a heap profile to stderr after every `interval`-th
+    // full collection and at exit; 0 turns profiling off.
+    void              setHeapProfile(size_t interval);
+    bool              profiling() const;
+    GcHeapProfile&    profile();
+    void              printHeapProfile(std::ostream& out, const char* when);
 
    private:
-    GcHeap() = default;
-    void maybeCollect();
+    friend class GcMutatorScope;
+    friend class GcNativeScope;
+
+    // Stops every other running mutator for a collection, census or compaction and takes their
+    // pages, budgets and buffers back. Nests on the thread that holds it.
+    class WorldStop
+    {
+       public:
+        explicit WorldStop(GcHeap& heap);
+        ~WorldStop();
+
+        WorldStop(const WorldStop&)            = delete;
+        WorldStop& operator=(const WorldStop&) = delete;
+
+       private:
+        GcHeap&                      heap_;
+        std::unique_lock<std::mutex> lock_;
+    };
+    struct MutatorSlot;
+
+    GcHeap();
+    ~GcHeap();
+    void* allocateSlot(size_t sizeClass)
+    {
+        GcMutator&          self   = *running_;
+        GcAllocationBuffer& buffer = self.buffer;
+        size_t              bytes  = kSizeClasses[sizeClass];
+        if (buffer.budget >= bytes)
+        {
+            // Freed slots first, so survivors' pages fill up before fresh memory is touched.
+            if (GcPage* page = self.pages[sizeClass])
+            {
+                if (void* mem = page->allocateFree())
+                {
+                    buffer.budget -= bytes;
+                    self.objects.store(self.objects.load(std::memory_order_relaxed) + 1,
+                                       std::memory_order_relaxed);
+                    return mem;
+                }
+            }
+            GcBumpRun& run = buffer.runs[sizeClass];
+            if (static_cast<size_t>(run.limit - run.cursor) >= bytes)
+            {
+                void* mem = run.cursor;
+                run.cursor += bytes;
+                buffer.budget -= bytes;
+                return mem;
+            }
+        }
+        return allocateSlow(sizeClass, bytes);
+    }
+    void* allocateSlow(size_t sizeClass, size_t bytes);
+    void* takeSlot(GcMutator& self, size_t sizeClass, size_t bytes);
+    void  notifyGrowthSlow(const GcObject* owner, size_t bytes);
+    void  collectForAllocation();
+    bool  collectionDue() const;
+    void  safepointSlow();
+    void  updateSafepointRequest();
+
+    // Mutator bookkeeping; see gc_mutator.cpp. Everything taking a lock must hold heapMutex_.
+    GcMutator& mutator();
+    void       enter();
+    void       leave();
+    bool       suspend();
+    void       resume();
+    void       park(std::unique_lock<std::mutex>& lock, MutatorState state);
+    void       settle(GcMutator& mutator);
+    void       retire(GcMutator& mutator);
+    void       detach(GcMutator& mutator);
+    bool       othersAtSafepoints() const;
+
+    void remember(GcObject* obj);
+    void shade(GcObject* obj);
+    void forgetRemembered();
     void markPhase();
-    void sweepPhase();
+    void markInto(GcObject* obj, std::vector<GcObject*>& stack);
+    void drainMarkStack();
+    void drainParallel();
+    void drainIncrement(std::chrono::steady_clock::time_point deadline);
+    // Returns the bytes the traced object occupies, slot plus payload.
+    size_t traceObject(GcObject* obj, std::vector<GcObject*>& stack);
+    void   updateReferences();
+
+    GcPageSpace                   space_;
+    size_t                        nurseryBytes_   = 0;
+    size_t                        nurseryLimit_   = kNurseryBytes;  // next minor GC or mark step
+    size_t                        liveBytes_      = 0;  // old generation, as of the last mark
+    size_t                        markedBytes_    = 0;
+    size_t                        nextCollection_ = kMinHeapBytes;
+    size_t                        markDeadline_   = 0;  // a cycle finishes at once past this
+    size_t                        growthPercent_  = kDefaultGrowthPercent;
+    size_t                        markThreads_    = kDefaultMarkThreads;
+    std::chrono::microseconds     pauseBudget_{kDefaultPauseBudgetUs};
+    bool                          minor_          = false;
+    std::atomic<bool>             marking_{false};
+    bool                          inPause_        = false;
+    bool                          asyncSweep_     = kDefaultBackgroundSweep;
+    size_t                        compactPercent_ = kDefaultCompactPercent;
+    std::atomic<bool>             compactDue_{false};
+    bool                          compacting_     = false;
+    bool                          pinning_        = false;  // marking from unmovable roots
+    std::vector<GcObject*>        remembered_;
+    std::vector<GcObject*>        markStack_;  // marked objects whose children are pending
+    GcObject*                     partialArray_ = nullptr;  // large array traced across steps
+    size_t                        partialIndex_ = 0;
+    std::unordered_set<GcObject*> externalMarks_;  // functions live outside the page space
+    std::mutex                    externalMutex_;  // guards externalMarks_ during parallel marking
+    std::vector<GcObject*>        markedFunctions_;  // kept by a compacting mark for fix-ups
+    GcForwardingTable             forwarding_;       // old address to new, mid-compaction
+    GcRootSet                     roots_;
+    GcPauseHistogram              pauses_;
+    GcStats                       counters_;  // running totals; the census is taken on demand
+    GcStatsLevel                  statsLevel_ = GcStatsLevel::Off;
+    GcHeapProfile                 profile_;
+    size_t                        profileInterval_ = 0;
+
+    // Threads: a collection raises stopping_ and waits, on worldCv_, until no other mutator is
+    // Running. The lock guards the page lists, the counters above and the mutator list, and is
+    // held by the collecting thread for the whole pause.
+    mutable std::mutex            heapMutex_;
+    std::condition_variable       worldCv_;
+    std::vector<GcMutator*>       mutators_;
+    std::atomic<bool>             stopping_{false};
+    std::atomic<bool>             safepointRequested_{false};  // stopping_ or compactDue_
+    std::atomic<std::thread::id>  collector_{};
 
-    GcObject* head_      = nullptr;
-    size_t    count_     = 0;
-    size_t    threshold_ = kInitialThreshold;
-    GcRootSet roots_;
+    // The calling thread's mutator while it runs inside a GcMutatorScope, else null.
+    inline static constinit thread_local GcMutator* running_ = nullptr;
 };
 
 }  // namespace druk::gc
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+
+namespace druk::gc
+{
+
+// Byte offsets of the fields compiled code writes when it allocates an object inline from a
+// GcAllocationBuffer, or reads when it finds a struct field through an inline cache. The object
+// types are not standard layout, so the offsets are measured on real objects once per process
+// rather than written down.
+struct GcObjectLayout
+{
+    // GcObject header
+    size_t young;
+    size_t remembered;
+    size_t kind;
+    size_t immortal;
+
+    // GcArray, with its elements stored inline
+    size_t arrayData;
+    size_t arraySize;
+    size_t arrayCapacity;
+    size_t arrayInline;
+
+    // GcStruct: its shape, then its field values stored like an array's elements
+    size_t structShape;
+    size_t structData;
+    size_t structSize;
+    size_t structCapacity;
+    size_t structInline;
+
+    static const GcObjectLayout& get();
+};
+
+}  // namespace druk::gc
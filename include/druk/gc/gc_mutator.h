@@ -0,0 +1,88 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "druk/gc/gc_config.h"
+
+namespace druk::gc
+{
+
+class GcObject;
+struct GcPage;
+
+// Where a mutator thread stands with respect to collections.
+enum class MutatorState : uint8_t
+{
+    Native,     // outside every GcMutatorScope: touches no heap object, never waited for
+    Running,    // running Druk code; a collection waits for it to reach a safepoint
+    Parked,     // stopped inside the heap (allocation, collection) with references in C++ locals
+    Safepoint,  // stopped in GcHeap::safepoint(), every reference in its roots
+};
+
+// Never-used slots at the end of a page a mutator claimed, handed out by bumping `cursor`.
+struct GcBumpRun
+{
+    std::byte* cursor = nullptr;
+    std::byte* limit  = nullptr;
+};
+
+// What allocation fast paths touch: the bytes the thread may still allocate before visiting the
+// shared heap, and one bump run per size class. JIT-compiled code allocates inline from it too
+// (GcHeap::allocationBuffer), so it is standard layout. A slot taken from a run only becomes
+// known to its page when the heap next settles the mutator.
+struct GcAllocationBuffer
+{
+    size_t                                     budget = 0;  // bytes reserved in the nursery
+    std::array<GcBumpRun, kSizeClasses.size()> runs{};
+};
+static_assert(std::is_standard_layout_v<GcAllocationBuffer>);
+
+// The heap's per-thread state. A thread allocates from pages no other thread touches, and
+// batches its bookkeeping into a byte budget, so the shared heap is only locked when the budget
+// runs out or a page fills up. Collections hand everything back: the budget returns to the
+// nursery, the pages to the shared lists, the buffers to the collector.
+struct GcMutator
+{
+    GcAllocationBuffer                       buffer;
+    std::atomic<MutatorState>                state{MutatorState::Native};
+    size_t                                   depth = 0;  // nested GcMutatorScopes
+    std::array<GcPage*, kSizeClasses.size()> pages{};    // where the runs are, plus free lists
+    size_t                                   oldGrowth = 0;  // budget spent on old objects
+    std::atomic<size_t>                      objects{0};  // free-list slots not yet counted
+    std::vector<GcObject*>                   remembered;
+    std::vector<GcObject*>                   gray;  // shaded by the barrier mid-cycle
+};
+
+// Runs the enclosing code as a mutator: allocation takes the thread's own pages and the thread
+// stops for other threads' collections only at safepoints. Any thread that runs Druk code while
+// another thread may use the heap must hold one; scopes nest.
+class GcMutatorScope
+{
+   public:
+    GcMutatorScope();
+    ~GcMutatorScope();
+
+    GcMutatorScope(const GcMutatorScope&)            = delete;
+    GcMutatorScope& operator=(const GcMutatorScope&) = delete;
+};
+
+// Leaves the heap around a blocking call (reading input, joining a thread), so other threads
+// can collect meanwhile. Heap references must be in roots across it.
+class GcNativeScope
+{
+   public:
+    GcNativeScope();
+    ~GcNativeScope();
+
+    GcNativeScope(const GcNativeScope&)            = delete;
+    GcNativeScope& operator=(const GcNativeScope&) = delete;
+
+   private:
+    bool running_;
+};
+
+}  // namespace druk::gc
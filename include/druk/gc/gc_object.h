@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
 namespace druk::gc
@@ -9,20 +10,37 @@ enum class GcType : uint8_t
     Array,
     String,
     Struct,
-    Function,
+    Function,  // ObjFunction: owned by the compiler, traced but never allocated on the heap
 };
 
+constexpr size_t kGcTypeCount = 4;
+
+const char* gcTypeName(GcType type);
+
+// Four bytes of header and no vtable: everything type-specific dispatches on `kind`, and mark
+// state lives in the owning page's bitmap.
 class GcObject
 {
    public:
-    GcObject* next   = nullptr;
-    bool      marked = false;
-    GcType    kind;
+    bool   young      = false;  // allocated since the last collection; set by GcHeap::alloc
+    bool   remembered = false;  // old object queued in the remembered set
+    GcType kind;
+    bool   immortal   = false;  // static data outside the heap: never marked, moved or freed
 
     explicit GcObject(GcType t) : kind(t) {}
-    virtual ~GcObject() = default;
 
-    virtual void trace() = 0;
+   protected:
+    // Not virtual: objects are only destroyed through destroyObject or as their own type.
+    ~GcObject() = default;
 };
 
+// Runs the destructor of the concrete type.
+void destroyObject(GcObject* obj);
+
+// Moves an object into the unused slot at `to`; `from` is destroyed afterwards.
+void relocateObject(GcObject* from, void* to);
+
+// Bytes an object owns outside its slot (spilled array elements and struct maps).
+size_t payloadBytes(const GcObject* obj);
+
 }  // namespace druk::gc
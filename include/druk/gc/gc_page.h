@@ -0,0 +1,155 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "druk/gc/gc_config.h"
+
+namespace druk::gc
+{
+
+class GcObject;
+
+// Where a compaction moved each object, keyed by its old address.
+using GcForwardingTable = std::unordered_map<GcObject*, GcObject*>;
+
+constexpr size_t sizeClassOf(size_t size)
+{
+    for (size_t i = 0; i < kSizeClasses.size(); ++i)
+        if (size <= kSizeClasses[i])
+            return i;
+    return kSizeClasses.size();
+}
+
+// Whether a page's dead objects from the last full collection have been freed yet.
+enum class SweepState : uint8_t
+{
+    Swept,
+    Pending,
+    Sweeping,  // claimed by the background sweeper or the allocator
+};
+
+// A page of equally sized slots. The header sits at the start of the (size-aligned) page, so
+// the page owning an object is found by masking its address; mark and live state are kept in
+// side bitmaps rather than in the objects.
+struct GcPage
+{
+    static constexpr size_t kMaxSlots = kPageSize / kSizeClasses[0];
+    static constexpr size_t kWords    = kMaxSlots / 64;
+
+    size_t     sizeClass = 0;
+    size_t     slotSize  = 0;
+    size_t     slotCount = 0;
+    size_t     bump      = 0;  // slots below this index have been handed out at least once
+    size_t     live      = 0;
+    bool       hasYoung  = false;
+    bool       pinned    = false;  // holds an object a compaction may not move
+    bool       owned     = false;  // a mutator thread allocates from it
+    void*      freeList  = nullptr;
+    std::byte* base      = nullptr;
+
+    std::atomic<SweepState>                   sweepState{SweepState::Swept};
+    std::array<uint64_t, kWords>              liveBits{};
+    std::array<std::atomic<uint64_t>, kWords> markBits{};  // set concurrently by mark workers
+
+    static GcPage* of(const void* ptr);
+
+    void*     allocate();
+    // Pops a free-list slot. While a mutator owns the page, the never-used slots from `bump` on
+    // belong to its bump run instead.
+    void*     allocateFree();
+    // Marks the slots a bump run handed out, from `bump` up to `cursor`, as allocated and
+    // returns how many there were.
+    size_t    commitRun(const std::byte* cursor);
+    bool      mark(const GcObject* obj);
+    GcObject* slot(size_t index) const;
+    size_t    indexOf(const GcObject* obj) const;
+};
+
+// Size-class segregated allocator. Each class allocates from its free lists first and then
+// bump-allocates fresh slots. Minor sweeps are a linear pass over the young pages' bitmaps; a
+// full sweep is lazy: each page is swept when the allocator reaches it, by an optional
+// background thread, or at the latest before the next full mark. The space itself is not
+// synchronized: GcHeap calls it under its lock, and only the owner touches a claimed page.
+class GcPageSpace
+{
+   public:
+    GcPageSpace() = default;
+    ~GcPageSpace();
+
+    GcPageSpace(const GcPageSpace&)            = delete;
+    GcPageSpace& operator=(const GcPageSpace&) = delete;
+
+    // Hands a page of the class with a free slot to one mutator thread, which then allocates
+    // from it without locking until it gives the page back.
+    GcPage* claim(size_t sizeClass);
+    void    release(GcPage* page) { page->owned = false; }
+    // Counts objects that mutators allocated from claimed pages.
+    void    addLive(size_t objects) { live_ += objects; }
+    // Gives an object too big for every size class a page of its own. Large pages are swept
+    // eagerly and released as soon as their object dies.
+    void* allocateLarge(size_t bytes);
+    // Frees the unmarked young objects.
+    void sweepMinor();
+    // Schedules every page for sweeping after a full mark; nothing is freed yet.
+    void beginSweep(bool background);
+    // Sweeps whatever beginSweep left pending. Must run before the next full mark.
+    void   finishSweep();
+    size_t liveCount() const;
+    // Percentage of the occupied small-object pages that compacting the survivors of the last
+    // full collection (or compaction) would release.
+    size_t fragmentation() const { return fragmentation_; }
+    // Bytes of page memory currently held, large pages included.
+    size_t committedBytes() const;
+
+    // Slides the live objects of every unpinned page of a size class towards its first pages,
+    // recording each move in `forwarding`, and releases the pages left empty. Classes that would
+    // not free a page are left alone. Requires a finished sweep and no young objects.
+    void compact(GcForwardingTable& forwarding);
+
+    // Calls fn(object, slotSize) for every allocated object. Dead objects still waiting for a
+    // lazy sweep are visited too, so finish the sweep first for an exact census.
+    template <typename Fn>
+    void forEachObject(Fn&& fn) const
+    {
+        auto visit = [&](const GcPage* page)
+        {
+            for (size_t w = 0; w < GcPage::kWords; ++w)
+                for (uint64_t bits = page->liveBits[w]; bits; bits &= bits - 1)
+                    fn(page->slot(w * 64 + static_cast<size_t>(std::countr_zero(bits))),
+                       page->slotSize);
+        };
+        for (const auto& pages : pages_)
+            for (const GcPage* page : pages) visit(page);
+        for (const GcPage* page : largePages_) visit(page);
+    }
+
+   private:
+    GcPage* newPage(size_t sizeClass);
+    size_t  sweepPage(GcPage* page, bool minor);
+    void    sweepPending(GcPage* page);
+    void    backgroundSweep(std::vector<GcPage*> pages);
+    void    stopSweeper();
+    void    releaseEmptyPages();
+    void    releaseEmptyLargePages();
+    void    slide(const std::vector<GcPage*>& pages, GcForwardingTable& forwarding);
+
+    std::array<std::vector<GcPage*>, kSizeClasses.size()> pages_;
+    std::array<size_t, kSizeClasses.size()>               current_{};
+    std::vector<GcPage*>                                  largePages_;
+    std::vector<GcPage*>                                  youngPages_;
+    size_t                                                live_          = 0;
+    size_t                                                pendingDead_   = 0;  // not yet swept
+    size_t                                                fragmentation_ = 0;  // percent
+    bool                                                  sweepPending_  = false;
+    std::thread                                           sweeper_;
+    std::atomic<bool>                                     stopSweeper_{false};
+    std::atomic<size_t>                                   sweeperFreed_{0};
+};
+
+}  // namespace druk::gc
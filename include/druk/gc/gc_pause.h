@@ -0,0 +1,33 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+
+namespace druk::gc
+{
+
+// Log2-bucketed histogram of collector pauses: bucket 0 counts pauses under 1us, bucket i
+// those in [2^(i-1), 2^i) us, and the last bucket everything longer.
+class GcPauseHistogram
+{
+   public:
+    static constexpr size_t kBuckets = 24;
+
+    void record(std::chrono::nanoseconds pause);
+    void reset();
+    void print(std::ostream& out) const;
+
+    size_t                   count() const { return count_; }
+    size_t                   bucket(size_t index) const { return buckets_[index]; }
+    std::chrono::nanoseconds max() const { return max_; }
+    std::chrono::nanoseconds total() const { return total_; }
+
+   private:
+    std::array<size_t, kBuckets> buckets_{};
+    size_t                       count_ = 0;
+    std::chrono::nanoseconds     max_{0};
+    std::chrono::nanoseconds     total_{0};
+};
+
+}  // namespace druk::gc
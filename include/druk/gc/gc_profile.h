@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "druk/gc/gc_object.h"
+#include "druk/gc/gc_page.h"
+
+namespace druk::gc
+{
+
+// Allocation-site profile: every object allocated while profiling remembers the site that was
+// current at the time, and print() takes a census of the live heap grouped by site and type.
+// Sites are registered by the code generator; site 0 stands for allocations made outside
+// compiled code. The current site is per thread.
+class GcHeapProfile
+{
+   public:
+    GcHeapProfile() : labels_{"<runtime>"} {}
+
+    uint32_t addSite(std::string label);
+    void     setSite(uint32_t site) { current_ = site; }
+    void     record(const GcObject* obj)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sites_[obj] = current_;
+    }
+    // Moves the sites of the objects a compaction relocated to their new addresses.
+    void     relocate(const GcForwardingTable& forwarding);
+
+    // Walks `space`, which must have no sweep pending, and forgets the sites of dead objects.
+    void print(std::ostream& out, const GcPageSpace& space, const char* when);
+
+   private:
+    std::vector<std::string>                      labels_;
+    std::unordered_map<const GcObject*, uint32_t> sites_;
+    std::mutex                                    mutex_;  // threads allocate concurrently
+
+    inline static thread_local uint32_t current_ = 0;
+};
+
+}  // namespace druk::gc
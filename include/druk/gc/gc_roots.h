@@ -1,23 +1,108 @@
 #pragma once
-#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
+namespace druk::codegen
+{
+class Value;
+}
+
 namespace druk::gc
 {
 
 class GcObject;
+class GcRootSet;
+
+// Marks whatever a custom root source holds; mark with GcHeap::markObject or Value::markGcRefs.
+// The matching update function rewrites those references after a compaction, through
+// GcHeap::forwarded or Value::updateGcRefs.
+using RootTraceFn = void (*)(void* context);
+
+// Owns one registration in a GcRootSet and drops it when destroyed. Move-only.
+class GcRootHandle
+{
+   public:
+    GcRootHandle() = default;
+    ~GcRootHandle();
+    GcRootHandle(GcRootHandle&& other) noexcept;
+    GcRootHandle& operator=(GcRootHandle&& other) noexcept;
+
+    GcRootHandle(const GcRootHandle&)            = delete;
+    GcRootHandle& operator=(const GcRootHandle&) = delete;
+
+    // Points a slot or value registration at new storage, e.g. after its vector reallocated.
+    void update(const void* data, size_t count);
+    void reset();
+    explicit operator bool() const { return set_ != nullptr; }
 
-using TraceCallback = std::function<void(GcObject*)>;
+   private:
+    friend class GcRootSet;
+    GcRootHandle(GcRootSet* set, size_t index) : set_(set), index_(index) {}
+
+    GcRootSet* set_   = nullptr;
+    size_t     index_ = 0;
+};
 
+// The roots of every collection. Sources are plain ranges the collector scans directly, with
+// an escape hatch for state that is not laid out contiguously. Registration and removal are
+// O(1): removed entries go on a free list and are reused by the next registration.
+//
+// A compaction rewrites slot, value and stack ranges in place. Callbacks registered without an
+// update function cannot follow moved objects, so whatever they mark is pinned instead.
+// Threads register and drop roots concurrently; a collection holds the set's lock while it
+// traces.
 class GcRootSet
 {
    public:
-    void addSource(TraceCallback cb);
-    void removeSource(const TraceCallback* cb);
-    void traceAll() const;
+    // `count` object pointers from `slots`; null entries are skipped.
+    [[nodiscard]] GcRootHandle addSlots(GcObject* const* slots, size_t count);
+    // `count` values from `values`.
+    [[nodiscard]] GcRootHandle addValues(const codegen::Value* values, size_t count);
+    // Values from `base` up to wherever `*top` points when the collection runs.
+    [[nodiscard]] GcRootHandle addStack(const codegen::Value*         base,
+                                        const codegen::Value* const* top);
+    [[nodiscard]] GcRootHandle addCallback(RootTraceFn trace, void* context,
+                                           RootTraceFn update = nullptr);
+
+    size_t size() const;
+    // Marks every root. `pinning`, when given, is raised while callbacks without an update
+    // function run.
+    void   traceAll(bool* pinning = nullptr) const;
+    // Rewrites every root through the forwarding table of a running compaction.
+    void   updateAll();
 
    private:
-    std::vector<TraceCallback> sources_;
+    friend class GcRootHandle;
+
+    enum class RootKind : uint8_t
+    {
+        Free,
+        Slots,
+        Values,
+        Stack,
+        Callback,
+    };
+
+    struct Root
+    {
+        RootKind                     kind    = RootKind::Free;
+        const void*                  data    = nullptr;  // slots, values or stack base
+        size_t                       count   = 0;  // entries; the next free index when free
+        const codegen::Value* const* top     = nullptr;
+        RootTraceFn                  trace   = nullptr;
+        void*                        context = nullptr;
+        RootTraceFn                  update  = nullptr;
+    };
+
+    GcRootHandle add(Root root);
+    void         remove(size_t index);
+
+    std::vector<Root>  roots_;
+    size_t             freeHead_  = SIZE_MAX;
+    size_t             freeCount_ = 0;
+    mutable std::mutex mutex_;
 };
 
 }  // namespace druk::gc
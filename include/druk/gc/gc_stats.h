@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include "druk/gc/gc_object.h"
+
+namespace druk::gc
+{
+
+// How much the heap reports on its own: Summary prints GcStats when the heap shuts down,
+// Verbose also logs one line per full collection. Reports go to stderr, never to program
+// output.
+enum class GcStatsLevel : uint8_t
+{
+    Off,
+    Summary,
+    Verbose,
+};
+
+// Counters since the heap started plus a census of the objects live right now.
+struct GcStats
+{
+    size_t   minorCollections = 0;
+    size_t   fullCollections  = 0;
+    size_t   markIncrements   = 0;
+    size_t   pauses           = 0;
+    uint64_t totalPauseUs     = 0;
+    uint64_t maxPauseUs       = 0;
+    size_t   bytesAllocated   = 0;
+    size_t   bytesFreed       = 0;
+    size_t   objectsFreed     = 0;
+    size_t   compactions      = 0;
+    size_t   objectsMoved     = 0;
+
+    size_t                           liveObjects    = 0;
+    size_t                           liveBytes      = 0;  // slots plus payloads
+    size_t                           committedBytes = 0;  // page memory held by the heap
+    std::array<size_t, kGcTypeCount> liveObjectsByType{};
+    std::array<size_t, kGcTypeCount> liveBytesByType{};
+
+    void print(std::ostream& out) const;
+};
+
+}  // namespace druk::gc
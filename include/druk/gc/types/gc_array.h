@@ -1,33 +1,100 @@
 #pragma once
-#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
 
+#include "druk/codegen/core/value.h"
 #include "druk/gc/gc_object.h"
 
-namespace druk::codegen
+namespace druk::gc
 {
-class Value;
-}
 
-namespace druk::gc
+// Element storage with the vector interface the runtime uses, for array elements and struct
+// fields. The first kInlineCapacity elements live in the object itself, so short arrays and
+// small structs are a single allocation; growing past them moves every element to one
+// out-of-line buffer. Values are trivially copyable, so elements are moved with plain copies and
+// never destroyed.
+class GcArrayElements
 {
+   public:
+    using Value                             = druk::codegen::Value;
+    static constexpr size_t kInlineCapacity = 4;
+    static_assert(std::is_trivially_copyable_v<Value>);
+
+    GcArrayElements() = default;
+    ~GcArrayElements();
+
+    // Takes over a spilled buffer or copies the inline elements, leaving `other` empty.
+    GcArrayElements(GcArrayElements&& other) noexcept;
+
+    GcArrayElements(const GcArrayElements&)            = delete;
+    GcArrayElements& operator=(const GcArrayElements&) = delete;
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool   empty() const { return size_ == 0; }
+    bool   spilled() const { return data_ != inlineData(); }
+
+    Value*       data() { return data_; }
+    const Value* data() const { return data_; }
+    Value*       begin() { return data_; }
+    Value*       end() { return data_ + size_; }
+    const Value* begin() const { return data_; }
+    const Value* end() const { return data_ + size_; }
 
-class GcHeap;
+    Value&       operator[](size_t index) { return data_[index]; }
+    const Value& operator[](size_t index) const { return data_[index]; }
+    Value&       back() { return data_[size_ - 1]; }
+
+    // Takes `value` by copy, since it may be one of the elements that grow() moves.
+    void push_back(Value value)
+    {
+        if (size_ == capacity_)
+            grow(size_ + 1);
+        new (data_ + size_++) Value(value);
+    }
+    void pop_back() { --size_; }
+    void reserve(size_t count)
+    {
+        if (count > capacity_)
+            grow(count);
+    }
+    void resize(size_t count)
+    {
+        reserve(count);
+        for (size_t i = size_; i < count; ++i) new (data_ + i) Value();
+        size_ = count;
+    }
+
+   private:
+    friend struct GcObjectLayout;
+
+    void         grow(size_t minCapacity);
+    Value*       inlineData() { return reinterpret_cast<Value*>(inline_); }
+    const Value* inlineData() const { return reinterpret_cast<const Value*>(inline_); }
+
+    Value* data_     = inlineData();
+    size_t size_     = 0;
+    size_t capacity_ = kInlineCapacity;
+    alignas(Value) std::byte inline_[kInlineCapacity * sizeof(Value)];
+};
 
 class GcArray final : public GcObject
 {
    public:
-    std::vector<druk::codegen::Value> elements;
+    GcArrayElements elements;
+
+    GcArray() : GcObject(GcType::Array) {}
 
-    GcArray();
-    ~GcArray() override;
+    // elements may point into the object itself, so it is never copied; the compactor moves
+    // arrays into their new slot with the move constructor.
+    GcArray(GcArray&& other) noexcept : GcObject(other), elements(std::move(other.elements)) {}
 
-    // Explicitly delete copy/move to avoid implicit instantiation of vector members
     GcArray(const GcArray&)            = delete;
     GcArray& operator=(const GcArray&) = delete;
-    GcArray(GcArray&&)                 = delete;
     GcArray& operator=(GcArray&&)      = delete;
-
-    void trace() override;
 };
 
 }  // namespace druk::gc
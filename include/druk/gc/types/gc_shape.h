@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace druk::gc
+{
+
+// The layout every struct that gained the same fields in the same order shares: each field
+// name maps to a slot in GcStruct::fields. Shapes form a tree rooted at the empty shape, one
+// child per field added, and are never freed, so a compiler or an inline cache may hold one by
+// address and find a field by comparing a struct's shape against it.
+class GcShape
+{
+   public:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    static const GcShape* empty();
+
+    // The shape with `name` appended as its last slot; the same parent and name always give
+    // the same shape.
+    const GcShape* with(std::string_view name) const;
+
+    // Where a struct of this shape keeps `name`, or kNoSlot.
+    uint32_t slotOf(std::string_view name) const
+    {
+        auto it = slots_.find(name);
+        return it == slots_.end() ? kNoSlot : it->second;
+    }
+
+    size_t                          size() const { return names_.size(); }
+    const std::vector<std::string>& names() const { return names_; }
+
+    GcShape(const GcShape&)            = delete;
+    GcShape& operator=(const GcShape&) = delete;
+
+   private:
+    GcShape() = default;
+
+    std::vector<std::string>                       names_;  // by slot
+    std::unordered_map<std::string_view, uint32_t> slots_;  // keys point into names_
+
+    // Children by the name they add; keys point into the child's names_.
+    mutable std::unordered_map<std::string_view, std::unique_ptr<GcShape>> transitions_;
+};
+
+}  // namespace druk::gc
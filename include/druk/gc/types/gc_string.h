@@ -1,19 +1,42 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 #include "druk/gc/gc_object.h"
 
 namespace druk::gc
 {
 
+// The characters follow the header in the same slot, NUL-terminated, so a string is a single
+// allocation. The slot is sized at run time: create strings with GcHeap::allocString.
 class GcString final : public GcObject
 {
    public:
-    std::string data;
+    // Concatenates both parts into the object's inline storage.
+    GcString(std::string_view left, std::string_view right);
 
-    explicit GcString(std::string s) : GcObject(GcType::String), data(std::move(s)) {}
+    GcString(const GcString&)            = delete;
+    GcString& operator=(const GcString&) = delete;
 
-    void trace() override;
+    static constexpr size_t allocationSize(size_t length)
+    {
+        return sizeof(GcString) + length + 1;
+    }
+
+    std::string_view view() const { return {chars(), length_}; }
+    const char*      chars() const { return reinterpret_cast<const char*>(this + 1); }
+    size_t           length() const { return length_; }
+
+   private:
+    char* mutableChars() { return reinterpret_cast<char*>(this + 1); }
+
+    uint32_t length_;
 };
 
+// The bytes of an immortal GcString holding `text`, for compilers that emit
+// string constants as read-only data. Nothing ever writes to such an object.
+std::string immortalStringImage(std::string_view text);
+
 }  // namespace druk::gc
@@ -1,28 +1,65 @@
 #pragma once
-#include <string>
-#include <unordered_map>
+#include <string_view>
+#include <utility>
 
 #include "druk/gc/gc_object.h"
+#include "druk/gc/types/gc_array.h"
+#include "druk/gc/types/gc_shape.h"
 
 
-namespace druk::codegen
-{
-class Value;
-}
-
 namespace druk::gc
 {
 
 class GcHeap;
 
+// A struct's field values, flat and in slot order; its shape says which field is where.
+// Structs built from the same literal share a shape, so compiled code can cache a field's slot
+// per shape instead of looking the name up (see GcObjectLayout).
 class GcStruct final : public GcObject
 {
    public:
-    std::unordered_map<std::string, druk::codegen::Value> fields;
+    using Value = druk::codegen::Value;
+
+    const GcShape*  shape = GcShape::empty();
+    GcArrayElements fields;
 
     GcStruct() : GcObject(GcType::Struct) {}
 
-    void trace() override;
+    // fields may point into the object itself, so, like GcArray, it is only ever moved.
+    GcStruct(GcStruct&& other) noexcept
+        : GcObject(other), shape(other.shape), fields(std::move(other.fields))
+    {
+    }
+
+    GcStruct(const GcStruct&)            = delete;
+    GcStruct& operator=(const GcStruct&) = delete;
+    GcStruct& operator=(GcStruct&&)      = delete;
+
+    Value* find(std::string_view name)
+    {
+        uint32_t slot = shape->slotOf(name);
+        return slot == GcShape::kNoSlot ? nullptr : &fields[slot];
+    }
+    const Value* find(std::string_view name) const
+    {
+        uint32_t slot = shape->slotOf(name);
+        return slot == GcShape::kNoSlot ? nullptr : &fields[slot];
+    }
+
+    // Overwrites the field, or adds it as the last slot by moving to the next shape. The caller
+    // runs the write barrier.
+    void set(std::string_view name, const Value& value)
+    {
+        if (Value* field = find(name))
+        {
+            *field = value;
+            return;
+        }
+        shape = shape->with(name);
+        fields.push_back(value);
+    }
+
+    size_t size() const { return fields.size(); }
 };
 
 }  // namespace druk::gc
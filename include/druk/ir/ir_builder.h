@@ -25,6 +25,12 @@ class IRBuilder
         return insert_block_;
     }
 
+    // Stamped on every instruction created from here on.
+    void setCurrentLine(uint32_t line)
+    {
+        current_line_ = line;
+    }
+
     // Instruction creation methods
     Instruction* createAdd(Value* left, Value* right, const std::string& name = "");
     Instruction* createSub(Value* left, Value* right, const std::string& name = "");
@@ -60,6 +66,11 @@ class IRBuilder
     Instruction* createIndexSet(Value* array_val, Value* index_val, Value* value);
     Instruction* createLen(Value* value, const std::string& name = "");
 
+    Instruction* createBuildStruct(const gc::GcShape* shape, const std::vector<Value*>& fields,
+                                   const std::string& name = "");
+    Instruction* createGetField(Value* object, std::string field, const std::string& name = "");
+    Instruction* createSetField(Value* object, std::string field, Value* value);
+
     Instruction* createPrint(Value* val);
     Instruction* createToString(Value* val);
     Instruction* createStringConcat(Value* l, Value* r);
@@ -69,6 +80,7 @@ class IRBuilder
 
    private:
     BasicBlock* insert_block_;
+    uint32_t    current_line_ = 0;
 
     void insert(std::unique_ptr<Instruction> inst);
 };
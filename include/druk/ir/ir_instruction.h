@@ -6,3 +6,4 @@
 #include "druk/ir/ir_instruction_memory.h"
 #include "druk/ir/ir_instruction_control.h"
 #include "druk/ir/ir_instruction_arrays.h"
+#include "druk/ir/ir_instruction_structs.h"
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "druk/ir/ir_opcode.h"
@@ -50,6 +51,16 @@ class Instruction : public Value
         parent_ = block;
     }
 
+    // Source line of the statement this instruction was generated for; 0 if unknown.
+    uint32_t getLine() const
+    {
+        return line_;
+    }
+    void setLine(uint32_t line)
+    {
+        line_ = line;
+    }
+
    protected:
     explicit Instruction(Opcode opcode) : opcode_(opcode), parent_(nullptr) {}
 
@@ -57,6 +68,7 @@ class Instruction : public Value
     Opcode              opcode_;
     std::vector<Value*> operands_;
     BasicBlock*         parent_;
+    uint32_t            line_ = 0;
 };
 
 }  // namespace druk::ir
@@ -16,6 +16,10 @@ class AllocaInst : public Instruction
     {
         return allocatedType_;
     }
+    void setAllocatedType(std::shared_ptr<Type> type)
+    {
+        allocatedType_ = std::move(type);
+    }
 
    private:
     std::shared_ptr<Type> allocatedType_;
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+
+#include "druk/ir/ir_instruction_base.h"
+
+namespace druk::gc
+{
+class GcShape;
+}
+
+namespace druk::ir
+{
+
+// A struct literal: one operand per field, in slot order of a shape fixed at compile time.
+class BuildStructInst : public Instruction
+{
+   public:
+    BuildStructInst(const gc::GcShape* shape, const std::vector<Value*>& fields);
+    std::string           toString() const override;
+    std::shared_ptr<Type> getType() const override;
+
+    const gc::GcShape* getShape() const
+    {
+        return shape_;
+    }
+
+   private:
+    const gc::GcShape* shape_;
+};
+
+class GetFieldInst : public Instruction
+{
+   public:
+    GetFieldInst(Value* object, std::string field);
+    std::string           toString() const override;
+    std::shared_ptr<Type> getType() const override;
+
+    const std::string& getField() const
+    {
+        return field_;
+    }
+
+   private:
+    std::string field_;
+};
+
+class SetFieldInst : public Instruction
+{
+   public:
+    SetFieldInst(Value* object, std::string field, Value* value);
+    std::string           toString() const override;
+    std::shared_ptr<Type> getType() const override;
+
+    const std::string& getField() const
+    {
+        return field_;
+    }
+
+   private:
+    std::string field_;
+};
+
+}  // namespace druk::ir
@@ -35,6 +35,9 @@ enum class Opcode
     BuildArray,
     IndexGet,
     IndexSet,
+    BuildStruct,
+    GetField,
+    SetField,
     Len,
     Push,
     Pop,
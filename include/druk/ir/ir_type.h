@@ -17,7 +17,8 @@ enum class TypeID
     Pointer,
     Function,
     Array,
-    Struct
+    Struct,
+    Dynamic  // Boxed runtime value whose type is only known at run time
 };
 
 /**
@@ -35,11 +36,18 @@ class Type
     }
     virtual std::string toString() const = 0;
 
+    /// True for types the backend keeps in registers instead of a boxed runtime value.
+    bool isUnboxed() const
+    {
+        return id_ == TypeID::Int64 || id_ == TypeID::Bool;
+    }
+
     static std::shared_ptr<Type> getVoidTy();
     static std::shared_ptr<Type> getInt8Ty();
     static std::shared_ptr<Type> getInt64Ty();
     static std::shared_ptr<Type> getFloat64Ty();
     static std::shared_ptr<Type> getBoolTy();
+    static std::shared_ptr<Type> getDynamicTy();
 
    private:
     TypeID id_;
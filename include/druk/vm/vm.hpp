@@ -2,12 +2,12 @@
 
 #include <memory>
 #include <string_view>
-#include <unordered_map>
 #include <vector>
 
 #include "druk/codegen/core/chunk.h"
 #include "druk/codegen/core/obj.h"
 #include "druk/codegen/core/value.h"
+#include "druk/gc/gc_roots.h"
 
 namespace druk::gc
 {
@@ -49,13 +49,15 @@ class VM
 
    private:
     InterpretResult run();
+    static void     traceRoots(void* vm);
+    static void     updateRoots(void* vm);
 
     void                  push(codegen::Value value);
     codegen::Value        pop();
     const codegen::Value& peek(int distance) const;
 
     void          runtimeError(const char* format, ...);
-    gc::GcString* storeString(std::string value);
+    gc::GcString* storeString(std::string_view value);
 
     size_t stackSize() const
     {
@@ -70,19 +72,24 @@ class VM
     codegen::Value*             stackBase_ = nullptr;
     codegen::Value*             stackTop_  = nullptr;
 
-    std::unordered_map<std::string_view, codegen::Value> globals_;
-    size_t                                               globalsVersion_ = 0;
-    struct GlobalCache
+    // Globals by slot (codegen::globalSlot); a chunk resolves each name it uses once.
+    struct Global
     {
-        std::string_view name{};
-        codegen::Value*  slot    = nullptr;
-        size_t           version = 0;
-    } globalCache_;
+        codegen::Value value;
+        bool           defined = false;
+    };
+    std::vector<Global> globals_;
+    Global&             global(uint32_t slot);
 
     std::vector<std::string> argvStorage_;
 
     codegen::Value lastResult_{};
 
+    // The value stack is scanned up to stackTop_; frames, globals and lastResult_ go through
+    // traceRoots, and updateRoots follows them after a compaction.
+    gc::GcRootHandle stackRoot_;
+    gc::GcRootHandle stateRoot_;
+
     friend class VMTest;
 };
 
@@ -1,5 +1,7 @@
 #include "druk/codegen/core/chunk.h"
 
+#include "druk/codegen/core/global_slots.h"
+
 namespace druk::codegen
 {
 
@@ -27,6 +29,54 @@ int Chunk::addConstant(Value value)
     return static_cast<int>(constants_.size() - 1);
 }
 
+namespace
+{
+
+// Bytes of operand that follow each opcode, as the VM reads them.
+size_t operandBytes(OpCode op)
+{
+    switch (op)
+    {
+        case OpCode::Jump:
+        case OpCode::JumpIfFalse:
+        case OpCode::Loop:
+            return 2;
+        case OpCode::Constant:
+        case OpCode::GetLocal:
+        case OpCode::SetLocal:
+        case OpCode::GetGlobal:
+        case OpCode::DefineGlobal:
+        case OpCode::SetGlobal:
+        case OpCode::Call:
+        case OpCode::BuildArray:
+        case OpCode::BuildStruct:
+        case OpCode::GetField:
+        case OpCode::SetField:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+}  // namespace
+
+void Chunk::resolveGlobals()
+{
+    globalSlots_.assign(constants_.size(), kUnresolvedSlot);
+    for (size_t offset = 0; offset < code_.size();)
+    {
+        auto op = static_cast<OpCode>(code_[offset]);
+        if ((op == OpCode::GetGlobal || op == OpCode::DefineGlobal || op == OpCode::SetGlobal) &&
+            offset + 1 < code_.size())
+        {
+            uint8_t index = code_[offset + 1];
+            if (index < constants_.size() && constants_[index].isString())
+                globalSlots_[index] = globalSlot(constants_[index].asString());
+        }
+        offset += 1 + operandBytes(op);
+    }
+}
+
 void Chunk::patch(size_t offset, uint8_t byte)
 {
     if (offset < code_.size())
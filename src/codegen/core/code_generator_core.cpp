@@ -36,14 +36,15 @@ bool CodeGenerator::generate(const std::vector<parser::ast::Stmt*>& statements)
         {
             auto* funcDecl = static_cast<parser::ast::FuncDecl*>(stmt);
             auto  funcName = std::string(funcDecl->name.text(source_));
-            // For now, assume all functions return i64 (PackedValue)
-            auto  funcTy   = ir::Type::getInt64Ty();
+            // Functions return a boxed value; only locals are unboxed for now
+            auto  funcTy   = ir::Type::getDynamicTy();
             auto  func     = std::make_unique<ir::Function>(funcName, funcTy, &module_);
             
             for (uint32_t i = 0; i < funcDecl->paramCount; ++i)
             {
                 auto paramName = std::string(funcDecl->params[i].name.text(source_));
-                auto param     = std::make_unique<ir::Parameter>(paramName, ir::Type::getInt64Ty(), i);
+                auto param     = std::make_unique<ir::Parameter>(paramName,
+                                                                 ir::Type::getDynamicTy(), i);
                 func->addParameter(std::move(param));
             }
 
@@ -64,6 +65,7 @@ bool CodeGenerator::generate(const std::vector<parser::ast::Stmt*>& statements)
         builder_.createRet();
     }
 
+    refineLocalTypes(mainFunc.get());
     module_.addFunction(std::move(mainFunc));
 
     return !errors_.hasErrors();
@@ -71,8 +73,10 @@ bool CodeGenerator::generate(const std::vector<parser::ast::Stmt*>& statements)
 
 void CodeGenerator::visit(parser::ast::Stmt* stmt)
 {
-    if (stmt)
-        stmt->accept(this);
+    if (!stmt)
+        return;
+    builder_.setCurrentLine(stmt->token.line);
+    stmt->accept(this);
 }
 
 void CodeGenerator::visit(parser::ast::Expr* expr)
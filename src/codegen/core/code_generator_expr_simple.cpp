@@ -78,6 +78,17 @@ void CodeGenerator::visitAssignment(parser::ast::AssignmentExpr* expr)
             return;
         }
     }
+    if (auto* memberExpr = dynamic_cast<parser::ast::MemberAccessExpr*>(expr->target))
+    {
+        visit(memberExpr->object);
+        if (auto* object_val = lastValue_)
+        {
+            builder_.createSetField(object_val, std::string(memberExpr->memberName.text(source_)),
+                                    val);
+            lastValue_ = val;
+            return;
+        }
+    }
     lastValue_ = nullptr;
 }
 
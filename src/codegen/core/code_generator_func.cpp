@@ -28,14 +28,15 @@ void CodeGenerator::visitFunc(parser::ast::FuncDecl* stmt)
     {
         // This shouldn't happen for top-level functions in two-pass,
         // but might for nested functions if we don't pre-register them.
-        auto funcTy = ir::Type::getInt64Ty();
+        auto funcTy = ir::Type::getDynamicTy();
         auto func   = std::make_unique<ir::Function>(funcName, funcTy, &module_);
         funcPtr     = func.get();
         
         for (uint32_t i = 0; i < stmt->paramCount; ++i)
         {
             auto paramName = std::string(stmt->params[i].name.text(source_));
-            auto param     = std::make_unique<ir::Parameter>(paramName, ir::Type::getInt64Ty(), i);
+            auto param     = std::make_unique<ir::Parameter>(paramName,
+                                                             ir::Type::getDynamicTy(), i);
             funcPtr->addParameter(std::move(param));
         }
         functions_[funcName] = funcPtr;
@@ -58,7 +59,7 @@ void CodeGenerator::visitFunc(parser::ast::FuncDecl* stmt)
     for (uint32_t i = 0; i < stmt->paramCount; ++i)
     {
         auto* param   = funcPtr->getParameter(i);
-        auto* alloca  = builder_.createAlloca(ir::Type::getInt64Ty());
+        auto* alloca  = builder_.createAlloca(ir::Type::getDynamicTy());
         auto* loadVal = builder_.createLoad(param);
         builder_.createStore(loadVal, alloca);
         auto paramName                        = std::string(stmt->params[i].name.text(source_));
@@ -72,6 +73,7 @@ void CodeGenerator::visitFunc(parser::ast::FuncDecl* stmt)
     {
         builder_.createRet();
     }
+    refineLocalTypes(funcPtr);
 
     // Restore context
     variables_stack_.pop_back();
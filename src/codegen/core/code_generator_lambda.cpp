@@ -11,7 +11,7 @@ namespace druk::codegen
 
 void CodeGenerator::visitLambda(parser::ast::LambdaExpr* expr)
 {
-    auto  funcTy     = ir::Type::getInt64Ty();
+    auto  funcTy     = ir::Type::getDynamicTy();
     auto  lambdaName = "lambda_" + std::to_string(lambdaCount_++);
     auto  lambdaFunc = std::make_unique<ir::Function>(lambdaName, funcTy, &module_);
     auto* lambdaPtr  = lambdaFunc.get();
@@ -26,7 +26,7 @@ void CodeGenerator::visitLambda(parser::ast::LambdaExpr* expr)
     for (uint32_t i = 0; i < expr->paramCount; ++i)
     {
         auto paramName = std::string(expr->params[i].name.text(source_));
-        auto param     = std::make_unique<ir::Parameter>(paramName, ir::Type::getInt64Ty(), i);
+        auto param     = std::make_unique<ir::Parameter>(paramName, ir::Type::getDynamicTy(), i);
         lambdaPtr->addParameter(std::move(param));
     }
 
@@ -39,7 +39,7 @@ void CodeGenerator::visitLambda(parser::ast::LambdaExpr* expr)
     for (uint32_t i = 0; i < expr->paramCount; ++i)
     {
         auto* param   = lambdaPtr->getParameter(i);
-        auto* alloca  = builder_.createAlloca(ir::Type::getInt64Ty());
+        auto* alloca  = builder_.createAlloca(ir::Type::getDynamicTy());
         auto* loadVal = builder_.createLoad(param);
         builder_.createStore(loadVal, alloca);
         auto paramName                        = std::string(expr->params[i].name.text(source_));
@@ -57,6 +57,7 @@ void CodeGenerator::visitLambda(parser::ast::LambdaExpr* expr)
             builder_.createRet();
     }
 
+    refineLocalTypes(lambdaPtr);
     module_.addFunction(std::move(lambdaFunc));
 
     // Restore context
@@ -17,13 +17,12 @@ void CodeGenerator::visitPrint(parser::ast::PrintStmt* stmt)
 
 void CodeGenerator::visitVar(parser::ast::VarDecl* stmt)
 {
-    // All variables in Druk are PackedValue on the stack (24 bytes)
-    // We'll use a placeholder for now or a proper IR type if available.
-    // For now, let's assume getInt64Ty() was a placeholder and we need more.
-    auto* alloca     = builder_.createAlloca(ir::Type::getInt64Ty()); // Still 8 bytes? 
-    // Wait, I should check if there's a better type.
-    // If IR doesn't have a PackedValue type, I'll use an array of 3 i64 or something.
-    auto  name       = std::string(stmt->name.text(source_));
+    // Statically int/bool locals start unboxed; refineLocalTypes() boxes them again if any
+    // later store disagrees with the inferred type.
+    auto  slotTy = stmt->initializer ? lowerType(stmt->initializer->type)
+                                     : ir::Type::getDynamicTy();
+    auto* alloca = builder_.createAlloca(slotTy);
+    auto  name   = std::string(stmt->name.text(source_));
     variables_stack_.back()[name] = alloca;
     if (stmt->initializer)
     {
@@ -0,0 +1,56 @@
+/**
+ * @file code_generator_struct.cpp
+ * @brief Struct literal and field access IR generation.
+ */
+
+#include "druk/codegen/core/code_generator.h"
+
+namespace druk::codegen
+{
+
+void CodeGenerator::visitStructLiteral(parser::ast::StructLiteralExpr* expr)
+{
+    std::vector<ir::Value*> fields;
+    fields.reserve(expr->fieldCount);
+
+    for (uint32_t i = 0; i < expr->fieldCount; ++i)
+    {
+        visit(expr->fieldValues[i]);
+        if (!lastValue_)
+        {
+            errors_.report(util::Diagnostic{
+                util::DiagnosticsSeverity::Error,
+                {expr->token.line, 0, expr->token.offset, expr->token.length},
+                "Struct field could not be evaluated.",
+                ""});
+            lastValue_ = nullptr;
+            return;
+        }
+        fields.push_back(lastValue_);
+    }
+
+    // The type checker lists the fields in source order, so every struct this literal builds
+    // has the same shape, known now rather than rediscovered field by field at run time.
+    lastValue_ = builder_.createBuildStruct(lowerShape(expr->type), fields);
+}
+
+void CodeGenerator::visitMemberAccess(parser::ast::MemberAccessExpr* expr)
+{
+    visit(expr->object);
+    auto* object_val = lastValue_;
+
+    if (!object_val)
+    {
+        errors_.report(util::Diagnostic{
+            util::DiagnosticsSeverity::Error,
+            {expr->memberName.line, 0, expr->memberName.offset, expr->memberName.length},
+            "Member access could not be evaluated.",
+            ""});
+        lastValue_ = nullptr;
+        return;
+    }
+
+    lastValue_ = builder_.createGetField(object_val, std::string(expr->memberName.text(source_)));
+}
+
+}  // namespace druk::codegen
@@ -8,16 +8,6 @@
 namespace druk::codegen
 {
 
-void CodeGenerator::visitStructLiteral(parser::ast::StructLiteralExpr* expr)
-{
-    lastValue_ = nullptr;
-}
-
-void CodeGenerator::visitMemberAccess(parser::ast::MemberAccessExpr* expr)
-{
-    lastValue_ = nullptr;
-}
-
 void CodeGenerator::visitBuiltinType(parser::ast::BuiltinType* type) {}
 void CodeGenerator::visitArrayType(parser::ast::ArrayType* type) {}
 void CodeGenerator::visitFunctionType(parser::ast::FunctionType* type) {}
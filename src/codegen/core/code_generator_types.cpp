@@ -0,0 +1,66 @@
+/**
+ * @file code_generator_types.cpp
+ * @brief Mapping of semantic types onto IR types for unboxed locals, and onto struct shapes.
+ */
+
+#include "druk/codegen/core/code_generator.h"
+#include "druk/gc/types/gc_shape.h"
+#include "druk/ir/ir_basic_block.h"
+#include "druk/ir/ir_function.h"
+#include "druk/ir/ir_instruction.h"
+#include "druk/ir/ir_type.h"
+
+namespace druk::codegen
+{
+
+std::shared_ptr<ir::Type> CodeGenerator::lowerType(const semantic::Type& type) const
+{
+    switch (type.kind)
+    {
+        case semantic::TypeKind::Int:
+            return ir::Type::getInt64Ty();
+        case semantic::TypeKind::Bool:
+            return ir::Type::getBoolTy();
+        default:
+            return ir::Type::getDynamicTy();
+    }
+}
+
+const gc::GcShape* CodeGenerator::lowerShape(const semantic::Type& type) const
+{
+    const gc::GcShape* shape = gc::GcShape::empty();
+    for (const auto& field : type.fields) shape = shape->with(field.name);
+    return shape;
+}
+
+void CodeGenerator::refineLocalTypes(ir::Function* func)
+{
+    // The type checker is optimistic (calls and indexing report int), so a slot only stays
+    // unboxed if every store into it provably produces the same type. Demoting one slot can
+    // change the type of loads feeding other stores, hence the fixed point.
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (const auto& block : func->getBasicBlocks())
+        {
+            for (const auto& inst : *block)
+            {
+                if (inst->getOpcode() != ir::Opcode::Store)
+                    continue;
+
+                auto* slot = dynamic_cast<ir::AllocaInst*>(inst->getOperand(1));
+                if (!slot || !slot->getAllocatedType()->isUnboxed())
+                    continue;
+
+                if (inst->getOperand(0)->getType()->getID() != slot->getAllocatedType()->getID())
+                {
+                    slot->setAllocatedType(ir::Type::getDynamicTy());
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace druk::codegen
@@ -0,0 +1,26 @@
+#include "druk/codegen/core/global_slots.h"
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace druk::codegen
+{
+
+uint32_t globalSlot(std::string_view name)
+{
+    static std::mutex                                     mutex;
+    static std::deque<std::string>                        names;  // stable storage for the keys
+    static std::unordered_map<std::string_view, uint32_t> slots;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto                        it = slots.find(name);
+    if (it != slots.end())
+        return it->second;
+    auto slot = static_cast<uint32_t>(names.size());
+    slots.emplace(names.emplace_back(name), slot);
+    return slot;
+}
+
+}  // namespace druk::codegen
@@ -29,7 +29,7 @@ Value::Value(ObjFunction* v) : type_(ValueType::Function)
 std::string_view Value::asString() const
 {
     assert(type_ == ValueType::String);
-    return data_.str->data;
+    return data_.str->view();
 }
 
 bool Value::operator==(const Value& other) const
@@ -45,7 +45,7 @@ bool Value::operator==(const Value& other) const
         case ValueType::Bool:
             return data_.b == other.data_.b;
         case ValueType::String:
-            return data_.str->data == other.data_.str->data;
+            return data_.str == other.data_.str || data_.str->view() == other.data_.str->view();
         case ValueType::Function:
             return data_.func == other.data_.func;
         case ValueType::Array:
@@ -58,25 +58,43 @@ bool Value::operator==(const Value& other) const
     return false;
 }
 
+gc::GcObject* Value::gcRef() const
+{
+    switch (type_)
+    {
+        case ValueType::String:
+            return data_.str;
+        case ValueType::Array:
+            return data_.arr;
+        case ValueType::Struct:
+            return data_.struc;
+        case ValueType::Function:
+            return reinterpret_cast<gc::GcObject*>(data_.func);
+        default:
+            return nullptr;
+    }
+}
+
 void Value::markGcRefs() const
 {
-    auto& heap = gc::GcHeap::get();
+    gc::GcHeap::get().markObject(gcRef());
+}
+
+void Value::updateGcRefs()
+{
     switch (type_)
     {
         case ValueType::String:
-            heap.markObject(data_.str);
+            data_.str = static_cast<gc::GcString*>(gc::GcHeap::get().forwarded(data_.str));
             break;
         case ValueType::Array:
-            heap.markObject(data_.arr);
+            data_.arr = static_cast<gc::GcArray*>(gc::GcHeap::get().forwarded(data_.arr));
             break;
         case ValueType::Struct:
-            heap.markObject(data_.struc);
-            break;
-        case ValueType::Function:
-            heap.markObject(reinterpret_cast<gc::GcObject*>(data_.func));
+            data_.struc = static_cast<gc::GcStruct*>(gc::GcHeap::get().forwarded(data_.struc));
             break;
         default:
-            break;
+            break;  // immediates, and functions, which never move
     }
 }
 
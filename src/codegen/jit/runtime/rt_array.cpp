@@ -6,9 +6,12 @@ extern "C"
 {
     void druk_jit_build_array(const PackedValue* elements, int32_t count, PackedValue* out)
     {
-        auto* arr = druk::gc::GcHeap::get().alloc<druk::gc::GcArray>();
+        auto& heap = druk::gc::GcHeap::get();
+        auto* arr  = heap.alloc<druk::gc::GcArray>();
+        arr->elements.reserve(static_cast<size_t>(count));
         for (int32_t i = 0; i < count; ++i)
             arr->elements.push_back(druk::codegen::runtime::unpack_value(&elements[i]));
+        heap.notifyGrowth(arr, druk::gc::payloadBytes(arr));
         druk::codegen::runtime::pack_value(druk::codegen::Value(arr), out);
     }
 
@@ -39,7 +42,11 @@ extern "C"
             auto*   p = arr.asGcArray();
             int64_t i = idx.asInt();
             if (i >= 0 && static_cast<size_t>(i) < p->elements.size())
-                p->elements[static_cast<size_t>(i)] = druk::codegen::runtime::unpack_value(val);
+            {
+                druk::codegen::Value v = druk::codegen::runtime::unpack_value(val);
+                p->elements[static_cast<size_t>(i)] = v;
+                druk::gc::GcHeap::get().writeBarrier(p, v.gcRef());
+            }
         }
     }
 
@@ -60,7 +67,15 @@ extern "C"
     {
         druk::codegen::Value v = druk::codegen::runtime::unpack_value(arr_val);
         if (v.isArray())
-            v.asGcArray()->elements.push_back(druk::codegen::runtime::unpack_value(element));
+        {
+            auto&                heap = druk::gc::GcHeap::get();
+            druk::codegen::Value e    = druk::codegen::runtime::unpack_value(element);
+            auto*                arr  = v.asGcArray();
+            size_t               had  = druk::gc::payloadBytes(arr);
+            arr->elements.push_back(e);
+            heap.writeBarrier(arr, e.gcRef());
+            heap.notifyGrowth(arr, druk::gc::payloadBytes(arr) - had);
+        }
     }
 
     void druk_jit_pop_array(PackedValue* arr_val, PackedValue* out)
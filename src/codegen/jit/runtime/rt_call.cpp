@@ -1,18 +1,66 @@
+#include <atomic>
+#include <mutex>
+
 #include "druk/codegen/core/obj.h"
 #include "druk/codegen/core/value.h"
 #include "rt_internal.h"
 
+namespace
+{
+
+// Runs `fn` with the callee and its arguments pushed as the innermost call frame.
+void invokeInFrame(DrukJitFunc fn, const PackedValue* callee, const PackedValue* args,
+                   int32_t count, PackedValue* out)
+{
+    auto&  stack = druk::codegen::runtime::g_arg_stack;
+    size_t base  = stack.size();
+    stack.push_back(*callee);
+    stack.insert(stack.end(), args, args + count);
+    druk::codegen::runtime::g_call_frames.push_back({base, static_cast<size_t>(count) + 1});
+    fn(out);
+    druk::codegen::runtime::g_call_frames.pop_back();
+    stack.resize(base);
+}
+
+// Fills an empty entry of `cache` with `callee`. The thread that claims the entry stores the
+// body before it publishes the callee with a release store, so compiled code that matches the
+// callee also sees its body.
+void cacheCallee(DrukCallCache* cache, void* callee, void* impl)
+{
+    for (auto& e : cache->entries)
+    {
+        std::atomic_ref<void*> entry(e.entry);
+        void*                  empty = nullptr;
+        if (entry.load(std::memory_order_acquire) == callee)
+            return;  // another thread cached it first
+        if (!entry.compare_exchange_strong(empty, druk::codegen::runtime::kClaimedEntry,
+                                           std::memory_order_relaxed))
+            continue;
+        std::atomic_ref<void*>(e.impl).store(impl, std::memory_order_relaxed);
+        entry.store(callee, std::memory_order_release);
+        return;
+    }
+}
+
+}  // namespace
 
 extern "C"
 {
     void druk_jit_register_function(druk::codegen::ObjFunction* function, DrukJitFunc fn)
     {
-        if (function && fn)
+        if (!function || !fn)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(druk::codegen::runtime::g_tables_mutex);
             druk::codegen::runtime::g_compiled_functions[function] = fn;
+        }
+        std::atomic_ref<void*>(function->code)
+            .store(reinterpret_cast<void*>(fn), std::memory_order_release);
     }
 
     void druk_jit_set_compile_handler(DrukJitCompileFn fn)
     {
+        std::lock_guard<std::mutex> lock(druk::codegen::runtime::g_tables_mutex);
         druk::codegen::runtime::g_compile_handler = fn;
     }
 
@@ -22,12 +70,8 @@ extern "C"
         druk::codegen::Value c = druk::codegen::runtime::unpack_value(callee);
         if (c.isRawFunction())
         {
-            druk::codegen::runtime::CallFrame frame;
-            frame.args.push_back(*callee);
-            for (int32_t i = 0; i < count; ++i) frame.args.push_back(args[i]);
-            druk::codegen::runtime::g_call_frames.push_back(std::move(frame));
-            reinterpret_cast<DrukJitFunc>(c.asRawFunction())(out);
-            druk::codegen::runtime::g_call_frames.pop_back();
+            invokeInFrame(reinterpret_cast<DrukJitFunc>(c.asRawFunction()), callee, args, count,
+                          out);
             return;
         }
         if (!c.isFunction())
@@ -41,34 +85,70 @@ extern "C"
             druk_jit_value_nil(out);
             return;
         }
-        auto it = druk::codegen::runtime::g_compiled_functions.find(f);
-        if (it == druk::codegen::runtime::g_compiled_functions.end() &&
-            druk::codegen::runtime::g_compile_handler)
-            if (auto compiled = druk::codegen::runtime::g_compile_handler(f))
-                druk::codegen::runtime::g_compiled_functions[f] = compiled;
-
-        it = druk::codegen::runtime::g_compiled_functions.find(f);
-        if (it == druk::codegen::runtime::g_compiled_functions.end())
+        // The function keeps its code once found, so only the first call looks it up. The
+        // handler compiles outside the lock; a thread that races it just compiles twice.
+        std::atomic_ref<void*> code(f->code);
+        if (!code.load(std::memory_order_acquire))
+        {
+            DrukJitFunc      found   = nullptr;
+            DrukJitCompileFn compile = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(druk::codegen::runtime::g_tables_mutex);
+                auto it = druk::codegen::runtime::g_compiled_functions.find(f);
+                if (it != druk::codegen::runtime::g_compiled_functions.end())
+                    found = it->second;
+                compile = druk::codegen::runtime::g_compile_handler;
+            }
+            if (!found && compile)
+                found = compile(f);
+            if (found)
+                druk_jit_register_function(f, found);
+        }
+        void* fn = code.load(std::memory_order_acquire);
+        if (!fn)
         {
             druk_jit_value_nil(out);
             return;
         }
-        druk::codegen::runtime::CallFrame frame;
-        frame.args.push_back(*callee);
-        for (int32_t i = 0; i < count; ++i) frame.args.push_back(args[i]);
-        druk::codegen::runtime::g_call_frames.push_back(std::move(frame));
-        it->second(out);
-        druk::codegen::runtime::g_call_frames.pop_back();
+        invokeInFrame(reinterpret_cast<DrukJitFunc>(fn), callee, args, count, out);
+    }
+
+    void druk_jit_register_native(void* entry, void* impl, int32_t arity)
+    {
+        if (!entry || !impl)
+            return;
+        std::lock_guard<std::mutex> lock(druk::codegen::runtime::g_tables_mutex);
+        druk::codegen::runtime::g_native_bodies[entry] = {impl, arity};
+    }
+
+    void druk_jit_call_cached(DrukCallCache* cache, const PackedValue* callee,
+                              const PackedValue* args, int32_t count, PackedValue* out)
+    {
+        // Only entry points compiled in this process have a register body to cache.
+        if (callee->type == static_cast<uint8_t>(druk::codegen::ValueType::RawFunction))
+        {
+            void* impl = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(druk::codegen::runtime::g_tables_mutex);
+                auto it = druk::codegen::runtime::g_native_bodies.find(callee->data.ptr);
+                if (it != druk::codegen::runtime::g_native_bodies.end() &&
+                    it->second.arity == count)
+                    impl = it->second.impl;
+            }
+            if (impl)
+                cacheCallee(cache, callee->data.ptr, impl);
+        }
+        druk_jit_call(callee, args, count, out);
     }
 
     void druk_jit_get_arg(int32_t index, PackedValue* out)
     {
-        if (druk::codegen::runtime::g_call_frames.empty() || index < 0 ||
-            static_cast<size_t>(index) >= druk::codegen::runtime::g_call_frames.back().args.size())
+        const auto& frames = druk::codegen::runtime::g_call_frames;
+        if (frames.empty() || index < 0 || static_cast<size_t>(index) >= frames.back().count)
         {
             druk_jit_value_nil(out);
             return;
         }
-        *out = druk::codegen::runtime::g_call_frames.back().args[static_cast<size_t>(index)];
+        *out = druk::codegen::runtime::g_arg_stack[frames.back().base + static_cast<size_t>(index)];
     }
 }
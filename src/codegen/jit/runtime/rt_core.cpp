@@ -1,3 +1,4 @@
+#include "druk/codegen/core/global_slots.h"
 #include "druk/codegen/core/obj.h"
 #include "druk/codegen/core/value.h"
 #include "druk/gc/gc_heap.h"
@@ -11,27 +12,99 @@ namespace druk::codegen::runtime
 {
 
 std::vector<std::string>                      g_jit_args;
-std::unordered_map<std::string, Value>        g_globals;
-std::vector<CallFrame>                        g_call_frames;
+std::vector<Global>                           g_globals;
+thread_local std::vector<PackedValue>         g_arg_stack = []
+{
+    std::vector<PackedValue> stack;
+    stack.reserve(256);
+    return stack;
+}();
+thread_local std::vector<CallFrame>           g_call_frames;
+thread_local std::vector<RootFrame>           g_root_frames;
+std::mutex                                    g_tables_mutex;
 std::unordered_map<ObjFunction*, DrukJitFunc> g_compiled_functions;
-DrukJitCompileFn                              g_compile_handler  = nullptr;
-bool                                          g_roots_registered = false;
+std::unordered_map<void*, NativeBody>         g_native_bodies;
+DrukJitCompileFn                              g_compile_handler = nullptr;
+
+namespace
+{
+
+// A thread's stacks, as its root callback sees them from whichever thread collects.
+struct ThreadRoots
+{
+    std::vector<PackedValue>* args;
+    std::vector<RootFrame>*   frames;
+    gc::GcRootHandle          handle;
+};
+
+void traceGlobals(void*)
+{
+    std::lock_guard<std::mutex> lock(g_tables_mutex);
+    for (const auto& global : g_globals) global.value.markGcRefs();
+}
+
+void traceThreadRoots(void* context)
+{
+    auto* roots = static_cast<ThreadRoots*>(context);
+    for (const auto& arg : *roots->args) unpack_value(&arg).markGcRefs();
+    for (const auto& frame : *roots->frames)
+        for (int32_t i = 0; i < frame.count; ++i) unpack_value(&frame.slots[i]).markGcRefs();
+}
+
+void updatePacked(PackedValue* slot)
+{
+    Value value = unpack_value(slot);
+    value.updateGcRefs();
+    pack_value(value, slot);
+}
+
+void updateGlobals(void*)
+{
+    std::lock_guard<std::mutex> lock(g_tables_mutex);
+    for (auto& global : g_globals) global.value.updateGcRefs();
+}
+
+void updateThreadRoots(void* context)
+{
+    auto* roots = static_cast<ThreadRoots*>(context);
+    for (auto& arg : *roots->args) updatePacked(&arg);
+    for (const auto& frame : *roots->frames)
+        for (int32_t i = 0; i < frame.count; ++i) updatePacked(&frame.slots[i]);
+}
+
+}  // namespace
 
 void ensureRootsRegistered()
 {
-    if (g_roots_registered)
-        return;
-    g_roots_registered = true;
-    gc::GcHeap::get().roots().addSource(
-        [](gc::GcObject*)
-        {
-            for (auto& [k, v] : g_globals) v.markGcRefs();
-        });
+    // Function-local statics are created after the heap, so they are released before the heap
+    // is. The thread's handle is created after its stacks, so it is dropped before they are.
+    static gc::GcRootHandle globals =
+        gc::GcHeap::get().roots().addCallback(traceGlobals, nullptr, updateGlobals);
+    thread_local ThreadRoots roots{&g_arg_stack, &g_root_frames, {}};
+    if (!roots.handle)
+        roots.handle = gc::GcHeap::get().roots().addCallback(traceThreadRoots, &roots,
+                                                             updateThreadRoots);
 }
 
-gc::GcString* storeString(std::string s)
+Global& global(std::string_view name)
 {
-    return gc::GcHeap::get().alloc<gc::GcString>(std::move(s));
+    uint32_t slot = globalSlot(name);
+    if (slot >= g_globals.size())
+        g_globals.resize(slot + 1);
+    return g_globals[slot];
+}
+
+Global* findGlobal(std::string_view name)
+{
+    uint32_t slot = globalSlot(name);
+    if (slot >= g_globals.size() || !g_globals[slot].defined)
+        return nullptr;
+    return &g_globals[slot];
+}
+
+gc::GcString* storeString(std::string_view s)
+{
+    return gc::GcHeap::get().allocString(s);
 }
 
 Value unpack_value(const PackedValue* p)
@@ -61,8 +134,7 @@ Value unpack_value(const PackedValue* p)
 
 void pack_value(const Value& v, PackedValue* p)
 {
-    p->type  = static_cast<uint8_t>(v.type());
-    p->extra = 0;
+    p->type = static_cast<uint8_t>(v.type());
     switch (v.type())
     {
         case ValueType::Nil:
@@ -93,3 +165,27 @@ void pack_value(const Value& v, PackedValue* p)
 }
 
 }  // namespace druk::codegen::runtime
+
+extern "C"
+{
+    void druk_jit_push_roots(PackedValue* slots, int32_t count)
+    {
+        druk::codegen::runtime::ensureRootsRegistered();
+        druk::codegen::runtime::g_root_frames.push_back({slots, count});
+    }
+
+    void druk_jit_pop_roots()
+    {
+        druk::codegen::runtime::g_root_frames.pop_back();
+    }
+
+    void* druk_jit_alloc_buffer()
+    {
+        return &druk::gc::GcHeap::get().allocationBuffer();
+    }
+
+    void druk_jit_safepoint()
+    {
+        druk::gc::GcHeap::get().safepoint();
+    }
+}
@@ -9,30 +9,37 @@ extern "C"
     void druk_jit_set_args(const char** argv, int32_t argc)
     {
         druk::codegen::runtime::ensureRootsRegistered();
-        druk::codegen::runtime::g_jit_args.clear();
-        if (!argv || argc <= 0)
+        std::vector<std::string> args;
+        for (int32_t i = 0; argv && i < argc; ++i) args.emplace_back(argv[i] ? argv[i] : "");
+        if (args.empty())
+        {
+            std::lock_guard<std::mutex> lock(druk::codegen::runtime::g_tables_mutex);
+            druk::codegen::runtime::g_jit_args.clear();
             return;
-        for (int32_t i = 0; i < argc; ++i)
-            druk::codegen::runtime::g_jit_args.emplace_back(argv[i] ? argv[i] : "");
+        }
 
         auto* argv_array = druk::gc::GcHeap::get().alloc<druk::gc::GcArray>();
-        for (const auto& arg : druk::codegen::runtime::g_jit_args)
+        for (const auto& arg : args)
             argv_array->elements.push_back(
                 druk::codegen::Value(druk::codegen::runtime::storeString(arg)));
 
-        druk::codegen::runtime::g_globals["argv"] = druk::codegen::Value(argv_array);
-        druk::codegen::runtime::g_globals["argc"] =
-            druk::codegen::Value(static_cast<int64_t>(druk::codegen::runtime::g_jit_args.size()));
+        std::lock_guard<std::mutex> lock(druk::codegen::runtime::g_tables_mutex);
+        druk::codegen::runtime::global("argv") = {druk::codegen::Value(argv_array), true};
+        druk::codegen::runtime::global("argc") = {
+            druk::codegen::Value(static_cast<int64_t>(args.size())), true};
+        druk::codegen::runtime::g_jit_args = std::move(args);
     }
 
     void druk_jit_get_global(const char* name, size_t name_len, PackedValue* out)
     {
         druk::codegen::runtime::ensureRootsRegistered();
-        auto it = druk::codegen::runtime::g_globals.find(std::string(name, name_len));
-        if (it != druk::codegen::runtime::g_globals.end())
-            druk::codegen::runtime::pack_value(it->second, out);
+        std::unique_lock<std::mutex> lock(druk::codegen::runtime::g_tables_mutex);
+        const auto* global = druk::codegen::runtime::findGlobal(std::string_view(name, name_len));
+        if (global)
+            druk::codegen::runtime::pack_value(global->value, out);
         else
         {
+            lock.unlock();
             std::cerr << "Runtime Error: Undefined variable\n";
             druk_jit_value_nil(out);
         }
@@ -41,14 +48,16 @@ extern "C"
     void druk_jit_define_global(const char* name, size_t name_len, const PackedValue* val)
     {
         druk::codegen::runtime::ensureRootsRegistered();
-        druk::codegen::runtime::g_globals[std::string(name, name_len)] =
-            druk::codegen::runtime::unpack_value(val);
+        std::lock_guard<std::mutex> lock(druk::codegen::runtime::g_tables_mutex);
+        druk::codegen::runtime::global(std::string_view(name, name_len)) = {
+            druk::codegen::runtime::unpack_value(val), true};
     }
 
     void druk_jit_set_global(const char* name, size_t name_len, const PackedValue* val)
     {
-        auto it = druk::codegen::runtime::g_globals.find(std::string(name, name_len));
-        if (it != druk::codegen::runtime::g_globals.end())
-            it->second = druk::codegen::runtime::unpack_value(val);
+        std::lock_guard<std::mutex> lock(druk::codegen::runtime::g_tables_mutex);
+        auto* global = druk::codegen::runtime::findGlobal(std::string_view(name, name_len));
+        if (global)
+            global->value = druk::codegen::runtime::unpack_value(val);
     }
 }
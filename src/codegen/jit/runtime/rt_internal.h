@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "druk/codegen/core/value.h"
 #include "druk/codegen/jit/jit_runtime.h"
 
 
@@ -26,20 +29,63 @@ namespace runtime
 
 // Global state
 extern std::vector<std::string>               g_jit_args;
-extern std::unordered_map<std::string, Value> g_globals;
 
+// Globals by slot (codegen::globalSlot), shared with the numbering the VM uses.
+struct Global
+{
+    Value value;
+    bool  defined = false;
+};
+extern std::vector<Global> g_globals;
+
+// A dynamic call's arguments, the callee first, as a window on g_arg_stack. The stack only
+// grows to the deepest nesting seen, so a call allocates nothing once it is warm.
 struct CallFrame
 {
-    std::vector<PackedValue> args;
+    size_t base;
+    size_t count;
+};
+
+// One entry per active JIT frame: its PackedValue slots, registered on entry so the collector
+// can trace locals and temporaries precisely (see LLVMBackend::emit_gc_root_frame).
+struct RootFrame
+{
+    PackedValue* slots;
+    int32_t      count;
 };
 
-extern std::vector<CallFrame>                        g_call_frames;
+// Marks an inline cache entry that a thread has claimed and is still filling; never an address
+// that a cache holds.
+inline void* const kClaimedEntry = reinterpret_cast<void*>(uintptr_t{1});
+
+// The body behind a JIT entry point that takes its arguments in registers, for call caches.
+struct NativeBody
+{
+    void*   impl;
+    int32_t arity;
+};
+
+// Each thread running compiled code calls, and roots, on stacks of its own.
+extern thread_local std::vector<PackedValue> g_arg_stack;
+extern thread_local std::vector<CallFrame>   g_call_frames;
+extern thread_local std::vector<RootFrame>   g_root_frames;
+
+// Shared by every thread; g_tables_mutex guards them and the globals and arguments above.
+// Holders never allocate, so a collection never waits on a thread that holds it.
+extern std::mutex                                    g_tables_mutex;
 extern std::unordered_map<ObjFunction*, DrukJitFunc> g_compiled_functions;
+extern std::unordered_map<void*, NativeBody>         g_native_bodies;
 extern DrukJitCompileFn                              g_compile_handler;
 
 // Helpers
+// Registers the globals, and the calling thread's stacks, as roots the first time each is
+// needed.
 void          ensureRootsRegistered();
-gc::GcString* storeString(std::string s);
+// The global for `name`, growing g_globals to reach its slot; findGlobal only looks, and
+// returns nullptr for a name that is not defined.
+Global&       global(std::string_view name);
+Global*       findGlobal(std::string_view name);
+gc::GcString* storeString(std::string_view s);
 Value         unpack_value(const PackedValue* p);
 void          pack_value(const Value& v, PackedValue* p);
 
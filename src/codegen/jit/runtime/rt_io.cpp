@@ -2,6 +2,7 @@
 #include <string>
 
 #include "druk/codegen/core/value.h"
+#include "druk/gc/gc_mutator.h"
 #include "druk/lexer/unicode.hpp"
 #include "rt_internal.h"
 
@@ -11,9 +12,14 @@ extern "C"
     void druk_jit_input(PackedValue* out)
     {
         std::string l;
-        if (std::getline(std::cin, l))
+        bool        read;
+        {
+            druk::gc::GcNativeScope blocking;  // other threads may collect while this one waits
+            read = static_cast<bool>(std::getline(std::cin, l));
+        }
+        if (read)
             druk::codegen::runtime::pack_value(
-                druk::codegen::Value(druk::codegen::runtime::storeString(std::move(l))), out);
+                druk::codegen::Value(druk::codegen::runtime::storeString(l)), out);
         else
             druk::codegen::runtime::pack_value(
                 druk::codegen::Value(druk::codegen::runtime::storeString("")), out);
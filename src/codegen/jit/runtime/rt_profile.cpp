@@ -0,0 +1,18 @@
+#include <string>
+
+#include "rt_internal.h"
+
+
+extern "C"
+{
+    uint32_t druk_jit_register_alloc_site(const char* function, uint32_t line)
+    {
+        std::string label = function && *function ? function : "<main>";
+        return druk::gc::GcHeap::get().profile().addSite(label + ":" + std::to_string(line));
+    }
+
+    void druk_jit_set_alloc_site(uint32_t site)
+    {
+        druk::gc::GcHeap::get().profile().setSite(site);
+    }
+}
@@ -59,10 +59,12 @@ extern "C"
         auto left  = unpack_value(l);
         auto right = unpack_value(r);
 
-        std::string s1 = left.isString() ? std::string(left.asString()) : "";
-        std::string s2 = right.isString() ? std::string(right.asString()) : "";
+        // Both operands sit in rooted frame slots, so their bytes survive a collection inside
+        // allocString and are copied straight into the new string.
+        std::string_view s1 = left.isString() ? left.asString() : std::string_view();
+        std::string_view s2 = right.isString() ? right.asString() : std::string_view();
 
-        auto* gs = storeString(s1 + s2);
+        auto* gs = druk::gc::GcHeap::get().allocString(s1, s2);
         pack_value(druk::codegen::Value(gs), out);
     }
 }
@@ -1,20 +1,72 @@
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
 #include "druk/codegen/core/value.h"
 #include "rt_internal.h"
 
+namespace
+{
+
+// Where `s` keeps `field`: from `cache` if it has seen the struct's shape, otherwise looked up
+// and remembered in the first free entry, if there is one. The thread that claims the entry
+// stores the slot before it publishes the shape with a release store, so a reader that matches
+// the shape also sees its slot.
+uint32_t cachedSlot(DrukFieldCache* cache, const druk::gc::GcStruct* s, std::string_view field)
+{
+    for (auto& entry : cache->entries)
+        if (std::atomic_ref<const void*>(entry.shape).load(std::memory_order_acquire) == s->shape)
+            return static_cast<uint32_t>(
+                std::atomic_ref<int64_t>(entry.slot).load(std::memory_order_relaxed));
+
+    uint32_t slot = s->shape->slotOf(field);
+    if (slot == druk::gc::GcShape::kNoSlot)
+        return slot;
+    for (auto& entry : cache->entries)
+    {
+        std::atomic_ref<const void*> shape(entry.shape);
+        const void*                  empty = nullptr;
+        if (!shape.compare_exchange_strong(empty, druk::codegen::runtime::kClaimedEntry,
+                                           std::memory_order_relaxed))
+            continue;
+        std::atomic_ref<int64_t>(entry.slot).store(slot, std::memory_order_relaxed);
+        shape.store(s->shape, std::memory_order_release);
+        break;
+    }
+    return slot;
+}
+
+}  // namespace
 
 extern "C"
 {
-    void druk_jit_build_struct(const PackedValue* keys, const PackedValue* values, int32_t count,
+    // For code that cannot refer to a shape by address (executables): the literal names its
+    // fields instead, `names` holding `count` NUL-terminated names in order.
+    void druk_jit_build_struct(const char* names, const PackedValue* values, int32_t count,
                                PackedValue* out)
     {
-        auto* s = druk::gc::GcHeap::get().alloc<druk::gc::GcStruct>();
+        auto& heap = druk::gc::GcHeap::get();
+        auto* s    = heap.alloc<druk::gc::GcStruct>();
         for (int32_t i = 0; i < count; ++i)
         {
-            druk::codegen::Value k = druk::codegen::runtime::unpack_value(&keys[i]);
-            if (k.isString())
-                s->fields[std::string(k.asString())] =
-                    druk::codegen::runtime::unpack_value(&values[i]);
+            std::string_view name(names);
+            s->set(name, druk::codegen::runtime::unpack_value(&values[i]));
+            names += name.size() + 1;
         }
+        heap.notifyGrowth(s, druk::gc::payloadBytes(s));
+        druk::codegen::runtime::pack_value(druk::codegen::Value(s), out);
+    }
+
+    // For JIT code, which builds each literal with the shape it was given at compile time.
+    void druk_jit_new_struct(const void* shape, const PackedValue* values, PackedValue* out)
+    {
+        auto& heap = druk::gc::GcHeap::get();
+        auto* s    = heap.alloc<druk::gc::GcStruct>();
+        s->shape   = static_cast<const druk::gc::GcShape*>(shape);
+        s->fields.reserve(s->shape->size());
+        for (size_t i = 0; i < s->shape->size(); ++i)
+            s->fields.push_back(druk::codegen::runtime::unpack_value(&values[i]));
+        heap.notifyGrowth(s, druk::gc::payloadBytes(s));
         druk::codegen::runtime::pack_value(druk::codegen::Value(s), out);
     }
 
@@ -24,11 +76,9 @@ extern "C"
         druk::codegen::Value s = druk::codegen::runtime::unpack_value(struct_val);
         if (s.isStruct())
         {
-            auto* p  = s.asGcStruct();
-            auto  it = p->fields.find(std::string(field, field_len));
-            if (it != p->fields.end())
+            if (const auto* value = s.asGcStruct()->find(std::string_view(field, field_len)))
             {
-                druk::codegen::runtime::pack_value(it->second, out);
+                druk::codegen::runtime::pack_value(*value, out);
                 return;
             }
         }
@@ -40,8 +90,53 @@ extern "C"
     {
         druk::codegen::Value s = druk::codegen::runtime::unpack_value(struct_val);
         if (s.isStruct())
-            s.asGcStruct()->fields[std::string(field, field_len)] =
-                druk::codegen::runtime::unpack_value(val);
+        {
+            auto&                heap = druk::gc::GcHeap::get();
+            auto*                p    = s.asGcStruct();
+            druk::codegen::Value v    = druk::codegen::runtime::unpack_value(val);
+            size_t               had  = druk::gc::payloadBytes(p);
+            p->set(std::string_view(field, field_len), v);
+            heap.writeBarrier(p, v.gcRef());
+            heap.notifyGrowth(p, druk::gc::payloadBytes(p) - had);
+        }
+    }
+
+    void druk_jit_get_field_cached(DrukFieldCache* cache, const PackedValue* struct_val,
+                                   const char* field, size_t field_len, PackedValue* out)
+    {
+        druk::codegen::Value s = druk::codegen::runtime::unpack_value(struct_val);
+        if (s.isStruct())
+        {
+            auto*    p    = s.asGcStruct();
+            uint32_t slot = cachedSlot(cache, p, std::string_view(field, field_len));
+            if (slot != druk::gc::GcShape::kNoSlot)
+            {
+                druk::codegen::runtime::pack_value(p->fields[slot], out);
+                return;
+            }
+        }
+        druk_jit_value_nil(out);
+    }
+
+    void druk_jit_set_field_cached(DrukFieldCache* cache, PackedValue* struct_val,
+                                   const char* field, size_t field_len, const PackedValue* val)
+    {
+        druk::codegen::Value s = druk::codegen::runtime::unpack_value(struct_val);
+        if (!s.isStruct())
+            return;
+
+        auto*                p    = s.asGcStruct();
+        druk::codegen::Value v    = druk::codegen::runtime::unpack_value(val);
+        uint32_t             slot = cachedSlot(cache, p, std::string_view(field, field_len));
+        auto&  heap = druk::gc::GcHeap::get();
+        size_t had  = druk::gc::payloadBytes(p);
+        // A new field moves the struct to another shape, so only existing fields are cached.
+        if (slot != druk::gc::GcShape::kNoSlot)
+            p->fields[slot] = v;
+        else
+            p->set(std::string_view(field, field_len), v);
+        heap.writeBarrier(p, v.gcRef());
+        heap.notifyGrowth(p, druk::gc::payloadBytes(p) - had);
     }
 
     void druk_jit_keys(const PackedValue* val, PackedValue* out)
@@ -50,9 +145,9 @@ extern "C"
         if (v.isStruct())
         {
             auto* a = druk::gc::GcHeap::get().alloc<druk::gc::GcArray>();
-            for (const auto& p : v.asGcStruct()->fields)
+            for (const auto& name : v.asGcStruct()->shape->names())
                 a->elements.push_back(
-                    druk::codegen::Value(druk::codegen::runtime::storeString(p.first)));
+                    druk::codegen::Value(druk::codegen::runtime::storeString(name)));
             druk::codegen::runtime::pack_value(druk::codegen::Value(a), out);
         }
         else
@@ -65,7 +160,7 @@ extern "C"
         if (v.isStruct())
         {
             auto* a = druk::gc::GcHeap::get().alloc<druk::gc::GcArray>();
-            for (const auto& p : v.asGcStruct()->fields) a->elements.push_back(p.second);
+            for (const auto& field : v.asGcStruct()->fields) a->elements.push_back(field);
             druk::codegen::runtime::pack_value(druk::codegen::Value(a), out);
         }
         else
@@ -88,10 +183,8 @@ extern "C"
         }
         else if (c.isStruct() && it.isString())
         {
-            auto* s = c.asGcStruct();
             druk::codegen::runtime::pack_value(
-                druk::codegen::Value(s->fields.find(std::string(it.asString())) != s->fields.end()),
-                out);
+                druk::codegen::Value(c.asGcStruct()->find(it.asString()) != nullptr), out);
         }
         else
             druk::codegen::runtime::pack_value(druk::codegen::Value(false), out);
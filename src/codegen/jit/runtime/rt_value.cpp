@@ -8,21 +8,18 @@ extern "C"
     {
         out->type   = static_cast<uint8_t>(druk::codegen::ValueType::Nil);
         out->data.i = 0;
-        out->extra  = 0;
     }
 
     void druk_jit_value_bool(bool b, PackedValue* out)
     {
         out->type   = static_cast<uint8_t>(druk::codegen::ValueType::Bool);
         out->data.i = b;
-        out->extra  = 0;
     }
 
     void druk_jit_value_int(int64_t i, PackedValue* out)
     {
         out->type   = static_cast<uint8_t>(druk::codegen::ValueType::Int);
         out->data.i = i;
-        out->extra  = 0;
     }
 
     void druk_jit_value_function(druk::codegen::ObjFunction* fn, PackedValue* out)
@@ -34,7 +31,6 @@ extern "C"
         }
         out->type     = static_cast<uint8_t>(druk::codegen::ValueType::Function);
         out->data.ptr = fn;
-        out->extra    = 0;
     }
 
     void druk_jit_value_raw_function(void* ptr, PackedValue* out)
@@ -46,13 +42,12 @@ extern "C"
         }
         out->type     = static_cast<uint8_t>(druk::codegen::ValueType::RawFunction);
         out->data.ptr = ptr;
-        out->extra    = 0;
     }
 
     void druk_jit_string_literal(const char* data, size_t len, PackedValue* out)
     {
         druk::codegen::runtime::ensureRootsRegistered();
-        auto* gs = druk::codegen::runtime::storeString(std::string(data, len));
+        auto* gs = druk::codegen::runtime::storeString(std::string_view(data, len));
         druk::codegen::runtime::pack_value(druk::codegen::Value(gs), out);
     }
 
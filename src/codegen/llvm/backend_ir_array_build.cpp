@@ -4,6 +4,8 @@
 
 #include <llvm/IR/Constants.h>
 
+#include "druk/gc/gc_layout.h"
+#include "druk/gc/types/gc_array.h"
 #include "druk/ir/ir_instruction.h"
 
 namespace druk::codegen
@@ -31,7 +33,7 @@ void LLVMBackend::compile_array_build(ir::Instruction* inst, llvm::StructType* p
             ctx_->builder->CreateInBoundsGEP(array_ty, array_alloc, {zero, index});
         ctx_->builder->CreateMemCpy(elem_ptr, llvm::MaybeAlign(8), elem_val,
                                    llvm::MaybeAlign(8),
-                                   llvm::ConstantInt::get(i64_ty, 24));
+                                   llvm::ConstantInt::get(i64_ty, sizeof(PackedValue)));
     }
 
     llvm::Value* first_ptr =
@@ -41,14 +43,41 @@ void LLVMBackend::compile_array_build(ir::Instruction* inst, llvm::StructType* p
         llvm::ConstantInt::get(llvm::Type::getInt32Ty(*ctx_->context),
                                static_cast<int32_t>(count));
 
-    ctx_->builder->CreateCall(
-        ctx_->module->getOrInsertFunction(
-            "druk_jit_build_array",
-            llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
-                                    {packed_ptr_ty, llvm::Type::getInt32Ty(*ctx_->context),
-                                     packed_ptr_ty},
-                                    false)),
-        {first_ptr, count_val, res});
+    auto emit_build_call = [&]
+    {
+        ctx_->builder->CreateCall(
+            ctx_->module->getOrInsertFunction(
+                "druk_jit_build_array",
+                llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
+                                        {packed_ptr_ty, llvm::Type::getInt32Ty(*ctx_->context),
+                                         packed_ptr_ty},
+                                        false)),
+            {first_ptr, count_val, res});
+    };
+
+    // Elements that fit the array's inline storage are copied in directly; the elements
+    // pointer then points into the object itself, as a fresh GcArray's does.
+    auto emit_init = [&](llvm::Value* obj)
+    {
+        auto&                     b       = *ctx_->builder;
+        llvm::Type*               i8_ty   = b.getInt8Ty();
+        const gc::GcObjectLayout& layout  = gc::GcObjectLayout::get();
+        llvm::Value*              storage = b.CreateConstInBoundsGEP1_64(i8_ty, obj,
+                                                                         layout.arrayInline);
+        b.CreateStore(storage, b.CreateConstInBoundsGEP1_64(i8_ty, obj, layout.arrayData));
+        b.CreateStore(llvm::ConstantInt::get(i64_ty, count),
+                      b.CreateConstInBoundsGEP1_64(i8_ty, obj, layout.arraySize));
+        b.CreateStore(llvm::ConstantInt::get(i64_ty, gc::GcArrayElements::kInlineCapacity),
+                      b.CreateConstInBoundsGEP1_64(i8_ty, obj, layout.arrayCapacity));
+        if (count > 0)
+            b.CreateMemCpy(storage, llvm::MaybeAlign(8), first_ptr, llvm::MaybeAlign(8),
+                           count * sizeof(PackedValue));
+    };
+
+    if (count > gc::GcArrayElements::kInlineCapacity ||
+        !emit_inline_alloc(sizeof(gc::GcArray), gc::GcType::Array, res, packed_value_ty,
+                           emit_init, emit_build_call))
+        emit_build_call();
 
     ctx_->ir_values[inst] = res;
 }
@@ -38,29 +38,9 @@ void LLVMBackend::compile_binary_op(ir::Instruction* inst, llvm::StructType* pac
             fn = "druk_jit_divide";
             break;
         case ir::Opcode::Equal:
+        case ir::Opcode::NotEqual:
             fn = "druk_jit_equal";
             break;
-        case ir::Opcode::NotEqual:
-        {
-            llvm::Value* eq_tmp = create_entry_alloca(packed_value_ty);
-            ctx_->builder->CreateCall(
-                ctx_->module->getOrInsertFunction(
-                    "druk_jit_equal",
-                    llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
-                                            {packed_ptr_ty, packed_ptr_ty, packed_ptr_ty},
-                                            false)),
-                {lhs, rhs, eq_tmp});
-
-            ctx_->builder->CreateCall(
-                ctx_->module->getOrInsertFunction(
-                    "druk_jit_not",
-                    llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
-                                            {packed_ptr_ty, packed_ptr_ty}, false)),
-                {eq_tmp, res});
-
-            ctx_->ir_values[inst] = res;
-            return;
-        }
         case ir::Opcode::LessThan:
             fn = "druk_jit_less";
             break;
@@ -83,11 +63,32 @@ void LLVMBackend::compile_binary_op(ir::Instruction* inst, llvm::StructType* pac
             return;
     }
 
-    ctx_->builder->CreateCall(
-        ctx_->module->getOrInsertFunction(
-            fn, llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
-                                        {packed_ptr_ty, packed_ptr_ty, packed_ptr_ty}, false)),
-        {lhs, rhs, res});
+    auto* binary_fn_ty =
+        llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
+                                {packed_ptr_ty, packed_ptr_ty, packed_ptr_ty}, false);
+
+    // Out-of-line runtime call; only reached on the slow path for Int-typed opcodes.
+    auto emit_runtime_call = [&]()
+    {
+        if (inst->getOpcode() != ir::Opcode::NotEqual)
+        {
+            ctx_->builder->CreateCall(ctx_->module->getOrInsertFunction(fn, binary_fn_ty),
+                                      {lhs, rhs, res});
+            return;
+        }
+
+        llvm::Value* eq_tmp = create_entry_alloca(packed_value_ty);
+        ctx_->builder->CreateCall(ctx_->module->getOrInsertFunction(fn, binary_fn_ty),
+                                  {lhs, rhs, eq_tmp});
+        ctx_->builder->CreateCall(
+            ctx_->module->getOrInsertFunction(
+                "druk_jit_not", llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
+                                                        {packed_ptr_ty, packed_ptr_ty}, false)),
+            {eq_tmp, res});
+    };
+
+    if (!emit_int_fast_path(inst->getOpcode(), lhs, rhs, res, packed_value_ty, emit_runtime_call))
+        emit_runtime_call();
 
     ctx_->ir_values[inst] = res;
 }
@@ -11,19 +11,16 @@ void LLVMBackend::compile_single_function(ir::Function* function, llvm::StructTy
                                           llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty)
 {
     ctx_->ir_values.clear();
+    ctx_->ir_scalars.clear();
     ctx_->ir_blocks.clear();
     ctx_->current_ir_function = function;
     llvm::Function* llvmFunc  = ctx_->ir_functions[function];
     ctx_->llvm_function       = llvmFunc;
-    ctx_->ret_out             = llvmFunc->getArg(0);
-
-    for (size_t i = 0; i < function->getParameterCount(); ++i)
-    {
-        ir::Parameter*  irParam   = function->getParameter(i);
-        llvm::Argument* llvmParam = llvmFunc->getArg(i + 1);
-        ctx_->ir_values[irParam]  = llvmParam;
-    }
+    ctx_->alloc_buffer        = nullptr;
 
+    // The prologue takes the arguments and polls for a safepoint; a loop back to the first IR
+    // block then goes through its own poll rather than through the prologue.
+    llvm::BasicBlock* prologue = llvm::BasicBlock::Create(*ctx_->context, "prologue", llvmFunc);
     for (const auto& bb : function->getBasicBlocks())
     {
         llvm::BasicBlock* llvmBB =
@@ -31,15 +28,57 @@ void LLVMBackend::compile_single_function(ir::Function* function, llvm::StructTy
         ctx_->ir_blocks[bb.get()] = llvmBB;
     }
 
+    // Arguments arrive in registers, each spilled once into a frame slot, which roots it.
+    // Parameters are dynamically typed, since a dynamic call can pass anything.
+    ctx_->builder->SetInsertPoint(prologue);
+    for (size_t i = 0; i < function->getParameterCount(); ++i)
+    {
+        ir::Parameter* irParam = function->getParameter(i);
+        llvm::Value*   tag     = llvmFunc->getArg(2 * i);
+        llvm::Value*   payload = llvmFunc->getArg(2 * i + 1);
+        llvm::Value*   slot    = create_entry_alloca(packed_value_ty, irParam->getName());
+        store_value_pair(make_value_pair(tag, payload), slot);
+        ctx_->ir_values[irParam] = slot;
+    }
+    llvm::BasicBlock* body = ctx_->ir_blocks[function->getBasicBlocks().front().get()];
+    if (safepoint_polls_)
+        emit_safepoint_poll(*ctx_->builder, body);
+    else
+        ctx_->builder->CreateBr(body);
+
     for (const auto& bb : function->getBasicBlocks())
     {
         llvm::BasicBlock* llvmBB = ctx_->ir_blocks[bb.get()];
         ctx_->builder->SetInsertPoint(llvmBB);
+        uint32_t line = 0;  // reset per block: predecessors may have left any site current
         for (const auto& inst : *bb)
         {
+            if (profile_sites_ && inst->getLine() != line)
+            {
+                line = inst->getLine();
+                emit_alloc_site(function, line);
+            }
             compile_instruction(inst.get(), packed_value_ty, packed_ptr_ty, i64_ty);
+            // The callee sets sites of its own, so the caller's is set again before whatever
+            // comes next, even on the same line.
+            if (inst->getOpcode() == ir::Opcode::Call ||
+                inst->getOpcode() == ir::Opcode::DynamicCall)
+                line = 0;
         }
     }
+
+    emit_gc_root_frame(llvmFunc);
+}
+
+void LLVMBackend::emit_alloc_site(ir::Function* function, uint32_t line)
+{
+    uint32_t     site   = druk_jit_register_alloc_site(function->getName().c_str(), line);
+    llvm::Type*  i32_ty = llvm::Type::getInt32Ty(*ctx_->context);
+    ctx_->builder->CreateCall(
+        ctx_->module->getOrInsertFunction(
+            "druk_jit_set_alloc_site",
+            llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context), {i32_ty}, false)),
+        {llvm::ConstantInt::get(i32_ty, site)});
 }
 
 }  // namespace druk::codegen
@@ -8,6 +8,7 @@
 #include <llvm/TargetParser/Triple.h>
 
 #include "druk/codegen/llvm/llvm_backend.h"
+#include "druk/gc/gc_heap.h"
 #include "druk/ir/ir_module.h"
 
 namespace druk::codegen
@@ -19,16 +20,21 @@ LLVMBackend::CompiledFunc LLVMBackend::compileFunction(ir::Function* function)
         return nullptr;
     ir::Module* irModule = function->getParent();
     ctx_->ir_values.clear();
+    ctx_->ir_scalars.clear();
     ctx_->ir_blocks.clear();
     ctx_->ir_functions.clear();
     ctx_->ir_wrappers.clear();
-
-    llvm::Type*       i8_ty      = llvm::Type::getInt8Ty(*ctx_->context);
-    llvm::Type*       i64_ty     = llvm::Type::getInt64Ty(*ctx_->context);
-    llvm::ArrayType*  padding_ty = llvm::ArrayType::get(i8_ty, 7);
-    llvm::StructType* packed_value_ty =
-        llvm::StructType::get(*ctx_->context, {i8_ty, padding_ty, i64_ty, i64_ty}, false);
-    llvm::PointerType* packed_ptr_ty = llvm::PointerType::getUnqual(*ctx_->context);
+    ctx_->string_literals.clear();
+    profile_sites_   = gc::GcHeap::get().profiling();
+    // The heap profile records each object as the runtime allocates it.
+    inline_alloc_    = !profile_sites_;
+    call_caches_     = true;
+    inline_shapes_   = true;
+    safepoint_polls_ = true;
+
+    llvm::Type*        i64_ty          = llvm::Type::getInt64Ty(*ctx_->context);
+    llvm::StructType*  packed_value_ty = get_packed_value_type();
+    llvm::PointerType* packed_ptr_ty   = llvm::PointerType::getUnqual(*ctx_->context);
 
     if (irModule)
     {
@@ -46,6 +52,19 @@ LLVMBackend::CompiledFunc LLVMBackend::compileFunction(ir::Function* function)
             return nullptr;
     }
 
+    // Entry points and their register bodies, registered once compiled so that call caches can
+    // skip the entry (names first: the JIT may free the module once it has compiled it).
+    struct NativeNames
+    {
+        std::string entry;
+        std::string impl;
+        int32_t     arity;
+    };
+    std::vector<NativeNames> natives;
+    for (const auto& [irFunc, llvmWrap] : ctx_->ir_wrappers)
+        natives.push_back({llvmWrap->getName().str(), ctx_->ir_functions[irFunc]->getName().str(),
+                           static_cast<int32_t>(irFunc->getParameterCount())});
+
     optimize_module();
     auto tsm = llvm::orc::ThreadSafeModule(std::move(ctx_->module), std::move(ctx_->context));
     llvm::cantFail(ctx_->jit->addIRModule(std::move(tsm)));
@@ -57,6 +76,19 @@ LLVMBackend::CompiledFunc LLVMBackend::compileFunction(ir::Function* function)
     if (auto sym_lookup = ctx_->jit->lookup(func_name))
     {
         auto compiled = reinterpret_cast<CompiledFunc>(sym_lookup->getValue());
+        for (const auto& native : natives)
+        {
+            auto entry = ctx_->jit->lookup(native.entry);
+            auto impl  = ctx_->jit->lookup(native.impl);
+            if (entry && impl)
+                druk_jit_register_native(reinterpret_cast<void*>(entry->getValue()),
+                                         reinterpret_cast<void*>(impl->getValue()), native.arity);
+            else
+            {
+                llvm::consumeError(entry.takeError());
+                llvm::consumeError(impl.takeError());
+            }
+        }
         ctx_->context.reset(new llvm::LLVMContext());
         ctx_->module.reset(new llvm::Module("druk", *ctx_->context));
         ctx_->builder.reset(new llvm::IRBuilder<>(*ctx_->context));
@@ -77,18 +109,12 @@ void LLVMBackend::prepare_functions_and_wrappers(ir::Module&        module,
         if (funcName.empty() || funcName == "main")
             funcName = "druk_entry";
 
-        // 1. Create the implementation function: void (out*, arg1*, arg2*, ...)
-        std::vector<llvm::Type*> implParamTypes;
-        implParamTypes.push_back(packed_ptr_ty);  // out
-        for (size_t i = 0; i < irFunc->getParameterCount(); ++i)
-            implParamTypes.push_back(packed_ptr_ty);
-
-        llvm::FunctionType* implFuncType =
-            llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context), implParamTypes, false);
-
+        // 1. Create the implementation function: {tag, payload} (tag1, payload1, ...)
         std::string     implName = funcName + "_impl";
-        llvm::Function* llvmImpl = llvm::Function::Create(
-            implFuncType, llvm::Function::ExternalLinkage, implName, ctx_->module.get());
+        llvm::Function* llvmImpl =
+            llvm::Function::Create(get_impl_type(irFunc->getParameterCount()),
+                                   llvm::Function::ExternalLinkage, implName, ctx_->module.get());
+        llvmImpl->setCallingConv(llvm::CallingConv::Fast);
 
         ctx_->ir_functions[irFunc.get()] = llvmImpl;
 
@@ -107,8 +133,6 @@ void LLVMBackend::prepare_functions_and_wrappers(ir::Module&        module,
         ctx_->builder->SetInsertPoint(wrapBB);
 
         std::vector<llvm::Value*> callArgs;
-        callArgs.push_back(llvmWrap->getArg(0));  // out
-
         for (size_t i = 0; i < irFunc->getParameterCount(); ++i)
         {
             llvm::Value* argOut = create_entry_alloca(packed_value_ty, "arg_" + std::to_string(i));
@@ -120,10 +144,14 @@ void LLVMBackend::prepare_functions_and_wrappers(ir::Module&        module,
                                             false)),
                 {llvm::ConstantInt::get(llvm::Type::getInt32Ty(*ctx_->context), (uint32_t)i + 1),
                  argOut});
-            callArgs.push_back(argOut);
+            llvm::Value* pair = load_value_pair(argOut);
+            callArgs.push_back(ctx_->builder->CreateExtractValue(pair, 0));
+            callArgs.push_back(ctx_->builder->CreateExtractValue(pair, 1));
         }
 
-        ctx_->builder->CreateCall(llvmImpl, callArgs);
+        llvm::CallInst* result = ctx_->builder->CreateCall(llvmImpl, callArgs);
+        result->setCallingConv(llvm::CallingConv::Fast);
+        store_value_pair(result, llvmWrap->getArg(0));
         ctx_->builder->CreateRetVoid();
     }
 }
@@ -5,6 +5,7 @@
 
 #include "druk/codegen/core/value.h"
 #include "druk/codegen/llvm/llvm_backend.h"
+#include "druk/gc/types/gc_string.h"
 #include "druk/ir/ir_value.h"
 
 namespace druk::codegen
@@ -15,11 +16,15 @@ llvm::Value* LLVMBackend::get_llvm_value(ir::Value* value)
     if (ctx_->ir_values.count(value))
         return ctx_->ir_values[value];
 
-    llvm::Type*       i8_ty      = llvm::Type::getInt8Ty(*ctx_->context);
-    llvm::Type*       i64_ty     = llvm::Type::getInt64Ty(*ctx_->context);
-    llvm::ArrayType*  padding_ty = llvm::ArrayType::get(i8_ty, 7);
-    llvm::StructType* packed_value_ty =
-        llvm::StructType::get(*ctx_->context, {i8_ty, padding_ty, i64_ty, i64_ty}, false);
+    // Unboxed values are boxed at each use that needs a PackedValue; the box is not cached since
+    // the use may not dominate later ones.
+    auto scalar = ctx_->ir_scalars.find(value);
+    if (scalar != ctx_->ir_scalars.end())
+        return box_scalar(scalar->second, value->getType()->getID());
+
+    llvm::Type*       i8_ty           = llvm::Type::getInt8Ty(*ctx_->context);
+    llvm::Type*       i64_ty          = llvm::Type::getInt64Ty(*ctx_->context);
+    llvm::StructType* packed_value_ty = get_packed_value_type();
 
     if (auto* cInt = dynamic_cast<ir::ConstantInt*>(value))
     {
@@ -32,9 +37,6 @@ llvm::Value* LLVMBackend::get_llvm_value(ir::Value* value)
         llvm::Value* dataPtr = ctx_->builder->CreateStructGEP(packed_value_ty, alloc, 2);
         ctx_->builder->CreateStore(llvm::ConstantInt::get(i64_ty, cInt->getValue()), dataPtr);
 
-        llvm::Value* extraPtr = ctx_->builder->CreateStructGEP(packed_value_ty, alloc, 3);
-        ctx_->builder->CreateStore(llvm::ConstantInt::get(i64_ty, 0), extraPtr);
-
         return alloc;
     }
     else if (auto* cBool = dynamic_cast<ir::ConstantBool*>(value))
@@ -49,30 +51,31 @@ llvm::Value* LLVMBackend::get_llvm_value(ir::Value* value)
         ctx_->builder->CreateStore(llvm::ConstantInt::get(i64_ty, cBool->getValue() ? 1 : 0),
                                    dataPtr);
 
-        llvm::Value* extraPtr = ctx_->builder->CreateStructGEP(packed_value_ty, alloc, 3);
-        ctx_->builder->CreateStore(llvm::ConstantInt::get(i64_ty, 0), extraPtr);
-
         return alloc;
     }
     else if (auto* cStr = dynamic_cast<ir::ConstantString*>(value))
     {
-        llvm::Value*    alloc = create_entry_alloca(packed_value_ty, "const_str");
-        llvm::Constant* strConst =
-            llvm::ConstantDataArray::getString(*ctx_->context, cStr->getValue());
-        llvm::GlobalVariable* strGlobal =
-            new llvm::GlobalVariable(*ctx_->module, strConst->getType(), true,
-                                     llvm::GlobalValue::PrivateLinkage, strConst, ".str");
-        llvm::Value* strPtr =
-            ctx_->builder->CreateBitCast(strGlobal, llvm::PointerType::getUnqual(*ctx_->context));
+        // The string object itself is module data, emitted once per distinct literal; using it
+        // allocates nothing.
+        llvm::GlobalVariable*& strGlobal = ctx_->string_literals[cStr->getValue()];
+        if (!strGlobal)
+        {
+            llvm::Constant* image = llvm::ConstantDataArray::getString(
+                *ctx_->context, gc::immortalStringImage(cStr->getValue()), false);
+            strGlobal = new llvm::GlobalVariable(*ctx_->module, image->getType(), true,
+                                                 llvm::GlobalValue::PrivateLinkage, image, ".str");
+            strGlobal->setAlignment(llvm::Align(alignof(gc::GcString)));
+        }
+
+        llvm::Value* alloc = create_entry_alloca(packed_value_ty, "const_str");
+
+        llvm::Value* typePtr = ctx_->builder->CreateStructGEP(packed_value_ty, alloc, 0);
+        ctx_->builder->CreateStore(
+            llvm::ConstantInt::get(i8_ty, static_cast<uint8_t>(ValueType::String)), typePtr);
+
+        llvm::Value* dataPtr = ctx_->builder->CreateStructGEP(packed_value_ty, alloc, 2);
+        ctx_->builder->CreateStore(ctx_->builder->CreatePtrToInt(strGlobal, i64_ty), dataPtr);
 
-        ctx_->builder->CreateCall(
-            ctx_->module->getOrInsertFunction(
-                "druk_jit_string_literal",
-                llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
-                                        {llvm::PointerType::getUnqual(*ctx_->context), i64_ty,
-                                         llvm::PointerType::getUnqual(*ctx_->context)},
-                                        false)),
-            {strPtr, llvm::ConstantInt::get(i64_ty, cStr->getValue().size()), alloc});
         return alloc;
     }
 
@@ -101,9 +104,6 @@ llvm::Value* LLVMBackend::get_llvm_value(ir::Value* value)
         llvm::Value* dataPtr = ctx_->builder->CreateStructGEP(packed_value_ty, alloc, 2);
         ctx_->builder->CreateStore(llvm::ConstantInt::get(i64_ty, 0), dataPtr);
 
-        llvm::Value* extraPtr = ctx_->builder->CreateStructGEP(packed_value_ty, alloc, 3);
-        ctx_->builder->CreateStore(llvm::ConstantInt::get(i64_ty, 0), extraPtr);
-
         return alloc;
     }
     return nullptr;
@@ -20,7 +20,7 @@ void LLVMBackend::compile_control_flow(ir::Instruction* inst, llvm::StructType*
         {
             if (auto* br = dynamic_cast<ir::BranchInst*>(inst))
             {
-                ctx_->builder->CreateBr(ctx_->ir_blocks[br->getDest()]);
+                ctx_->builder->CreateBr(branch_target(br->getDest()));
             }
             break;
         }
@@ -29,46 +29,45 @@ void LLVMBackend::compile_control_flow(ir::Instruction* inst, llvm::StructType*
             if (auto* br = dynamic_cast<ir::CondBranchInst*>(inst))
             {
                 auto ops = br->getOperands();
-                if (ops.empty() || !get_llvm_value(ops[0]))
+                if (ops.empty())
                     break;
 
-                llvm::Value* condPacked = get_llvm_value(ops[0]);
-                llvm::Value* condInt    = ctx_->builder->CreateCall(
-                    ctx_->module->getOrInsertFunction(
-                        "druk_jit_value_as_bool_int",
-                        llvm::FunctionType::get(llvm::Type::getInt32Ty(*ctx_->context),
-                                                   {packed_ptr_ty}, false)),
-                    {condPacked});
-
-                llvm::Value* condBool = ctx_->builder->CreateICmpNE(
-                    condInt, llvm::ConstantInt::get(llvm::Type::getInt32Ty(*ctx_->context), 0));
+                llvm::Value* condBool = nullptr;
+                if (ops[0]->getType()->getID() == ir::TypeID::Bool)
+                {
+                    // Statically boolean conditions branch on the i1 directly.
+                    condBool = get_scalar_value(ops[0]);
+                }
+                else if (llvm::Value* condPacked = get_llvm_value(ops[0]))
+                {
+                    llvm::Value* condInt = ctx_->builder->CreateCall(
+                        ctx_->module->getOrInsertFunction(
+                            "druk_jit_value_as_bool_int",
+                            llvm::FunctionType::get(llvm::Type::getInt32Ty(*ctx_->context),
+                                                    {packed_ptr_ty}, false)),
+                        {condPacked});
+                    condBool = ctx_->builder->CreateICmpNE(
+                        condInt,
+                        llvm::ConstantInt::get(llvm::Type::getInt32Ty(*ctx_->context), 0));
+                }
+                if (!condBool)
+                    break;
 
-                ctx_->builder->CreateCondBr(condBool, ctx_->ir_blocks[br->getTrueDest()],
-                                            ctx_->ir_blocks[br->getFalseDest()]);
+                ctx_->builder->CreateCondBr(condBool, branch_target(br->getTrueDest()),
+                                            branch_target(br->getFalseDest()));
             }
             break;
         }
         case ir::Opcode::Return:
         {
-            auto ops = inst->getOperands();
-            if (!ops.empty() && ctx_->ret_out)
-            {
-                llvm::Value* retVal = get_llvm_value(ops[0]);
-                ctx_->builder->CreateMemCpy(ctx_->ret_out, llvm::MaybeAlign(8), retVal,
-                                            llvm::MaybeAlign(8),
-                                            llvm::ConstantInt::get(i64_ty, 24));
-            }
-            else if (ctx_->ret_out)
-            {
-                ctx_->builder->CreateCall(
-                    ctx_->module->getOrInsertFunction(
-                        "druk_jit_value_nil",
-                        llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
-                                                {packed_ptr_ty}, false)),
-                    {ctx_->ret_out});
-            }
-
-            ctx_->builder->CreateRetVoid();
+            auto         ops    = inst->getOperands();
+            llvm::Value* retVal = ops.empty() ? nullptr : get_value_pair(ops[0]);
+            if (!retVal)
+                retVal = make_value_pair(
+                    llvm::ConstantInt::get(llvm::Type::getInt8Ty(*ctx_->context),
+                                           static_cast<uint8_t>(ValueType::Nil)),
+                    llvm::ConstantInt::get(i64_ty, 0));
+            ctx_->builder->CreateRet(retVal);
             break;
         }
         case ir::Opcode::Call:
@@ -96,35 +95,25 @@ void LLVMBackend::compile_call_op(ir::Instruction* inst, llvm::PointerType* pack
 
         llvm::Function* llvmFunc = it->second;
 
-        // Prepare arguments
+        // Arguments go in registers, tag and payload each
         std::vector<llvm::Value*> args;
-
-        // First argument is the return value
-        llvm::StructType* packed_value_ty = llvm::StructType::get(
-            *ctx_->context,
-            {llvm::Type::getInt8Ty(*ctx_->context),
-             llvm::ArrayType::get(llvm::Type::getInt8Ty(*ctx_->context), 7),
-             llvm::Type::getInt64Ty(*ctx_->context), llvm::Type::getInt64Ty(*ctx_->context)},
-            false);
-
-        llvm::Value* retVal = create_entry_alloca(packed_value_ty);
-        args.push_back(retVal);
-
-        // Add function parameters
-        auto operands = callInst->getOperands();
-        for (auto* operand : operands)
+        for (auto* operand : callInst->getOperands())
         {
-            llvm::Value* argVal = get_llvm_value(operand);
-            if (argVal)
-            {
-                args.push_back(argVal);
-            }
+            llvm::Value* pair = get_value_pair(operand);
+            if (!pair)
+                return;
+            args.push_back(ctx_->builder->CreateExtractValue(pair, 0));
+            args.push_back(ctx_->builder->CreateExtractValue(pair, 1));
         }
+        if (args.size() != llvmFunc->arg_size())
+            return;
 
-        // Create call
-        ctx_->builder->CreateCall(llvmFunc, args);
+        llvm::CallInst* call = ctx_->builder->CreateCall(llvmFunc, args);
+        call->setCallingConv(llvm::CallingConv::Fast);
 
-        // Store result
+        // The result lands in a frame slot, so it is rooted before anything can allocate
+        llvm::Value* retVal = create_entry_alloca(get_packed_value_type());
+        store_value_pair(call, retVal);
         ctx_->ir_values[inst] = retVal;
     }
 }
@@ -1,6 +1,9 @@
 #ifdef DRUK_HAVE_LLVM
 
 #include <llvm/IR/Constants.h>
+#include <llvm/IR/MDBuilder.h>
+
+#include <vector>
 
 #include "druk/codegen/llvm/llvm_backend.h"
 #include "druk/ir/ir_instruction.h"
@@ -15,10 +18,79 @@ void LLVMBackend::compile_dynamic_call_op(ir::Instruction* inst, llvm::StructTyp
     if (!dcall)
         return;
 
+    auto&        b         = *ctx_->builder;
     llvm::Value* calleeVal = get_llvm_value(dcall->getCallee());
+    uint32_t     argCount  = dcall->getOperandCount() - 1;
+    llvm::Value* outVal    = create_entry_alloca(packed_value_ty, "dcall_out");
+
+    // Inline cache: when the callee is an entry point this site has already called, call its
+    // body directly with the arguments in registers, bypassing the runtime and its argument
+    // stack. Entries only ever go from empty to filled.
+    llvm::Value*      cache  = llvm::ConstantPointerNull::get(packed_ptr_ty);
+    llvm::BasicBlock* contBB = nullptr;
+    if (call_caches_ && calleeVal)
+    {
+        llvm::StructType* entry_ty = llvm::StructType::get(packed_ptr_ty, packed_ptr_ty);
+        llvm::ArrayType*  cache_ty = llvm::ArrayType::get(entry_ty, kDrukCallCacheSize);
+        auto*             global   = new llvm::GlobalVariable(
+            *ctx_->module, cache_ty, false, llvm::GlobalValue::PrivateLinkage,
+            llvm::ConstantAggregateZero::get(cache_ty), "call_cache");
+        global->setAlignment(llvm::Align(alignof(DrukCallCache)));
+        cache = global;
+
+        llvm::Value* callee  = load_value_pair(calleeVal);
+        llvm::Value* payload = b.CreateExtractValue(callee, 1);
+        llvm::Value* impl    = llvm::ConstantPointerNull::get(packed_ptr_ty);
+        for (uint32_t i = kDrukCallCacheSize; i-- > 0;)
+        {
+            // Another thread may be filling the entry: `entry` is loaded with acquire, so a
+            // match sees the body stored before it.
+            auto field = [&](uint32_t f, llvm::AtomicOrdering ordering)
+            {
+                llvm::LoadInst* load = b.CreateLoad(
+                    packed_ptr_ty, b.CreateInBoundsGEP(cache_ty, global,
+                                                       {b.getInt32(0), b.getInt32(i),
+                                                        b.getInt32(f)}));
+                load->setAtomic(ordering);
+                load->setAlignment(llvm::Align(alignof(void*)));
+                return load;
+            };
+            llvm::Value* entry   = field(0, llvm::AtomicOrdering::Acquire);
+            llvm::Value* matches = b.CreateICmpEQ(b.CreatePtrToInt(entry, i64_ty), payload);
+            impl = b.CreateSelect(matches, field(1, llvm::AtomicOrdering::Monotonic), impl);
+        }
+        llvm::Value* isEntry = b.CreateICmpEQ(
+            b.CreateExtractValue(callee, 0),
+            b.getInt8(static_cast<uint8_t>(ValueType::RawFunction)));
+        llvm::Value* hit = b.CreateAnd(isEntry, b.CreateIsNotNull(impl), "cache_hit");
+
+        llvm::Function*   fn     = b.GetInsertBlock()->getParent();
+        llvm::BasicBlock* hitBB  = llvm::BasicBlock::Create(*ctx_->context, "cache_hit", fn);
+        llvm::BasicBlock* missBB = llvm::BasicBlock::Create(*ctx_->context, "cache_miss", fn);
+        contBB                   = llvm::BasicBlock::Create(*ctx_->context, "call_cont", fn);
+        llvm::MDBuilder md(*ctx_->context);
+        b.CreateCondBr(hit, hitBB, missBB, md.createBranchWeights(2000, 1));
+
+        b.SetInsertPoint(hitBB);
+        std::vector<llvm::Value*> args;
+        for (uint32_t i = 0; i < argCount; ++i)
+        {
+            llvm::Value* pair = get_value_pair(dcall->getOperand(i + 1));
+            if (!pair)
+                pair = make_value_pair(b.getInt8(static_cast<uint8_t>(ValueType::Nil)),
+                                       b.getInt64(0));
+            args.push_back(b.CreateExtractValue(pair, 0));
+            args.push_back(b.CreateExtractValue(pair, 1));
+        }
+        llvm::CallInst* result = b.CreateCall(get_impl_type(argCount), impl, args);
+        result->setCallingConv(llvm::CallingConv::Fast);
+        store_value_pair(result, outVal);
+        b.CreateBr(contBB);
+
+        b.SetInsertPoint(missBB);
+    }
 
     // Create an array of PackedValue for arguments on the stack
-    uint32_t     argCount  = dcall->getOperandCount() - 1;
     llvm::Value* argsArray = nullptr;
     if (argCount > 0)
     {
@@ -28,9 +100,9 @@ void LLVMBackend::compile_dynamic_call_op(ir::Instruction* inst, llvm::StructTyp
         for (uint32_t i = 0; i < argCount; ++i)
         {
             llvm::Value* argVal  = get_llvm_value(dcall->getOperand(i + 1));
-            llvm::Value* destPtr = ctx_->builder->CreateStructGEP(arrayTy, argsArray, i);
-            ctx_->builder->CreateMemCpy(destPtr, llvm::MaybeAlign(8), argVal, llvm::MaybeAlign(8),
-                                        llvm::ConstantInt::get(i64_ty, 24));
+            llvm::Value* destPtr = b.CreateStructGEP(arrayTy, argsArray, i);
+            b.CreateMemCpy(destPtr, llvm::MaybeAlign(8), argVal, llvm::MaybeAlign(8),
+                           llvm::ConstantInt::get(i64_ty, sizeof(PackedValue)));
         }
     }
     else
@@ -38,17 +110,31 @@ void LLVMBackend::compile_dynamic_call_op(ir::Instruction* inst, llvm::StructTyp
         argsArray = llvm::ConstantPointerNull::get(packed_ptr_ty);
     }
 
-    llvm::Value* outVal = create_entry_alloca(packed_value_ty, "dcall_out");
-
-    ctx_->builder->CreateCall(
-        ctx_->module->getOrInsertFunction(
-            "druk_jit_call",
-            llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
-                                    {packed_ptr_ty, packed_ptr_ty,
-                                     llvm::Type::getInt32Ty(*ctx_->context), packed_ptr_ty},
-                                    false)),
-        {calleeVal, ctx_->builder->CreateBitCast(argsArray, packed_ptr_ty),
-         llvm::ConstantInt::get(llvm::Type::getInt32Ty(*ctx_->context), argCount), outVal});
+    llvm::Type* i32_ty = llvm::Type::getInt32Ty(*ctx_->context);
+    if (contBB)
+    {
+        b.CreateCall(
+            ctx_->module->getOrInsertFunction(
+                "druk_jit_call_cached",
+                llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
+                                        {packed_ptr_ty, packed_ptr_ty, packed_ptr_ty, i32_ty,
+                                         packed_ptr_ty},
+                                        false)),
+            {cache, calleeVal, argsArray, llvm::ConstantInt::get(i32_ty, argCount), outVal});
+        b.CreateBr(contBB);
+        b.SetInsertPoint(contBB);
+    }
+    else
+    {
+        b.CreateCall(
+            ctx_->module->getOrInsertFunction(
+                "druk_jit_call",
+                llvm::FunctionType::get(llvm::Type::getVoidTy(*ctx_->context),
+                                        {packed_ptr_ty, packed_ptr_ty, i32_ty, packed_ptr_ty},
+                                        false)),
+            {calleeVal, b.CreateBitCast(argsArray, packed_ptr_ty),
+             llvm::ConstantInt::get(i32_ty, argCount), outVal});
+    }
 
     ctx_->ir_values[inst] = outVal;
 }
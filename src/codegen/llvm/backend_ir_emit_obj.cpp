@@ -19,16 +19,20 @@ namespace druk::codegen
 bool LLVMBackend::emitObjectFile(ir::Module& module, const std::string& obj_path)
 {
     ctx_->ir_values.clear();
+    ctx_->ir_scalars.clear();
     ctx_->ir_blocks.clear();
     ctx_->ir_functions.clear();
     ctx_->ir_wrappers.clear();
-
-    llvm::Type*       i8_ty      = llvm::Type::getInt8Ty(*ctx_->context);
-    llvm::Type*       i64_ty     = llvm::Type::getInt64Ty(*ctx_->context);
-    llvm::ArrayType*  padding_ty = llvm::ArrayType::get(i8_ty, 7);
-    llvm::StructType* packed_value_ty =
-        llvm::StructType::get(*ctx_->context, {i8_ty, padding_ty, i64_ty, i64_ty}, false);
-    llvm::PointerType* packed_ptr_ty = llvm::PointerType::getUnqual(*ctx_->context);
+    ctx_->string_literals.clear();
+    profile_sites_   = false;  // site ids only mean something inside this process
+    inline_alloc_    = false;  // executables run outside a mutator scope, with no budget to bump
+    call_caches_     = false;  // an executable's bodies are never registered with its runtime
+    inline_shapes_   = false;  // shapes and object layouts are this process's, not the target's
+    safepoint_polls_ = false;  // the heap's flag is this process's; executables run one thread
+
+    llvm::Type*        i64_ty          = llvm::Type::getInt64Ty(*ctx_->context);
+    llvm::StructType*  packed_value_ty = get_packed_value_type();
+    llvm::PointerType* packed_ptr_ty   = llvm::PointerType::getUnqual(*ctx_->context);
 
     prepare_functions_and_wrappers(module, packed_value_ty, packed_ptr_ty);
 
@@ -0,0 +1,81 @@
+#ifdef DRUK_HAVE_LLVM
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instructions.h>
+
+#include <vector>
+
+#include "druk/codegen/llvm/llvm_backend.h"
+
+namespace druk::codegen
+{
+
+void LLVMBackend::emit_gc_root_frame(llvm::Function* fn)
+{
+    llvm::StructType* packed_value_ty = get_packed_value_type();
+    llvm::BasicBlock& entry           = fn->getEntryBlock();
+
+    // Every PackedValue (or PackedValue array) alloca may hold a heap reference. Gather them
+    // so they can be folded into one contiguous frame the collector walks precisely.
+    std::vector<std::pair<llvm::AllocaInst*, uint64_t>> slots;
+    uint64_t                                            count = 0;
+    for (llvm::Instruction& inst : entry)
+    {
+        auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(&inst);
+        if (!alloca || !alloca->isStaticAlloca() || alloca->isArrayAllocation())
+            continue;
+
+        llvm::Type* type = alloca->getAllocatedType();
+        uint64_t    size = 0;
+        if (type == packed_value_ty)
+            size = 1;
+        else if (auto* array = llvm::dyn_cast<llvm::ArrayType>(type);
+                 array && array->getElementType() == packed_value_ty)
+            size = array->getNumElements();
+        if (size == 0)
+            continue;
+
+        slots.emplace_back(alloca, count);
+        count += size;
+    }
+    if (count == 0)
+        return;
+
+    llvm::IRBuilder<> entry_builder(&entry, entry.begin());
+    llvm::Type*       i32_ty   = entry_builder.getInt32Ty();
+    llvm::Type*       void_ty  = entry_builder.getVoidTy();
+    llvm::Type*       ptr_ty   = llvm::PointerType::getUnqual(*ctx_->context);
+    llvm::ArrayType*  frame_ty = llvm::ArrayType::get(packed_value_ty, count);
+
+    llvm::Value* frame = entry_builder.CreateAlloca(frame_ty, nullptr, "gc_roots");
+
+    // Zeroed slots read as nil, so a collection before a slot is first written is harmless.
+    entry_builder.CreateMemSet(frame, entry_builder.getInt8(0), count * sizeof(PackedValue),
+                               llvm::MaybeAlign(8));
+    entry_builder.CreateCall(
+        ctx_->module->getOrInsertFunction(
+            "druk_jit_push_roots", llvm::FunctionType::get(void_ty, {ptr_ty, i32_ty}, false)),
+        {frame, llvm::ConstantInt::get(i32_ty, count)});
+
+    // The old allocas are only erased once the builder no longer anchors on the first of them.
+    for (auto& [alloca, offset] : slots)
+    {
+        llvm::Value* slot = entry_builder.CreateInBoundsGEP(
+            frame_ty, frame, {entry_builder.getInt64(0), entry_builder.getInt64(offset)});
+        slot->takeName(alloca);
+        alloca->replaceAllUsesWith(slot);
+    }
+    for (auto& slot : slots) slot.first->eraseFromParent();
+
+    llvm::FunctionCallee pop_roots = ctx_->module->getOrInsertFunction(
+        "druk_jit_pop_roots", llvm::FunctionType::get(void_ty, false));
+    for (llvm::BasicBlock& block : *fn)
+    {
+        if (auto* ret = llvm::dyn_cast_or_null<llvm::ReturnInst>(block.getTerminator()))
+            llvm::IRBuilder<>(ret).CreateCall(pop_roots);
+    }
+}
+
+}  // namespace druk::codegen
+
+#endif  // DRUK_HAVE_LLVM
@@ -0,0 +1,117 @@
+#ifdef DRUK_HAVE_LLVM
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/MDBuilder.h>
+
+#include <cstddef>
+
+#include "druk/codegen/llvm/llvm_backend.h"
+#include "druk/gc/gc_layout.h"
+#include "druk/gc/gc_mutator.h"
+#include "druk/gc/gc_page.h"
+
+namespace druk::codegen
+{
+
+// Inline stores write PackedValues straight into heap objects, where the runtime reads Values.
+static_assert(sizeof(PackedValue) == sizeof(Value));
+
+llvm::Value* LLVMBackend::get_alloc_buffer()
+{
+    if (ctx_->alloc_buffer)
+        return ctx_->alloc_buffer;
+
+    // Fetched once in the entry block; the buffer belongs to the thread, not to a page, so the
+    // pointer stays valid across collections.
+    llvm::BasicBlock& entry = ctx_->llvm_function->getEntryBlock();
+    llvm::IRBuilder<> entry_builder(&entry, entry.begin());
+    ctx_->alloc_buffer = entry_builder.CreateCall(
+        ctx_->module->getOrInsertFunction(
+            "druk_jit_alloc_buffer",
+            llvm::FunctionType::get(llvm::PointerType::getUnqual(*ctx_->context), false)),
+        {}, "alloc_buffer");
+    return ctx_->alloc_buffer;
+}
+
+bool LLVMBackend::emit_inline_alloc(size_t bytes, gc::GcType kind, llvm::Value* res,
+                                    llvm::StructType*                      packed_value_ty,
+                                    llvm::function_ref<void(llvm::Value*)> emit_init,
+                                    llvm::function_ref<void()>             emit_slow_path)
+{
+    size_t size_class = gc::sizeClassOf(bytes);
+    if (!inline_alloc_ || size_class >= gc::kSizeClasses.size())
+        return false;
+
+    auto&                     b      = *ctx_->builder;
+    llvm::Type*               i8_ty  = b.getInt8Ty();
+    llvm::Type*               i64_ty = b.getInt64Ty();
+    llvm::Type*               ptr_ty = llvm::PointerType::getUnqual(*ctx_->context);
+    const gc::GcObjectLayout& layout = gc::GcObjectLayout::get();
+    uint64_t                  slot   = gc::kSizeClasses[size_class];
+
+    // The same test as GcHeap::allocateSlot, minus the free list: the slot must fit both the
+    // thread's budget and the size class's bump run.
+    llvm::Value* buffer = get_alloc_buffer();
+    llvm::Value* run    = b.CreateConstInBoundsGEP1_64(
+        i8_ty, buffer,
+        offsetof(gc::GcAllocationBuffer, runs) + size_class * sizeof(gc::GcBumpRun));
+    llvm::Value* budget_ptr =
+        b.CreateConstInBoundsGEP1_64(i8_ty, buffer, offsetof(gc::GcAllocationBuffer, budget));
+    llvm::Value* cursor_ptr =
+        b.CreateConstInBoundsGEP1_64(i8_ty, run, offsetof(gc::GcBumpRun, cursor));
+    llvm::Value* limit_ptr =
+        b.CreateConstInBoundsGEP1_64(i8_ty, run, offsetof(gc::GcBumpRun, limit));
+
+    llvm::Value* budget = b.CreateLoad(i64_ty, budget_ptr, "budget");
+    llvm::Value* cursor = b.CreateLoad(ptr_ty, cursor_ptr, "cursor");
+    llvm::Value* limit  = b.CreateLoad(ptr_ty, limit_ptr, "limit");
+    llvm::Value* room =
+        b.CreateSub(b.CreatePtrToInt(limit, i64_ty), b.CreatePtrToInt(cursor, i64_ty), "room");
+    llvm::Value* slot_size = llvm::ConstantInt::get(i64_ty, slot);
+    llvm::Value* fits      = b.CreateAnd(b.CreateICmpUGE(budget, slot_size),
+                                         b.CreateICmpUGE(room, slot_size), "fits");
+
+    llvm::BasicBlock* fast_bb =
+        llvm::BasicBlock::Create(*ctx_->context, "alloc_fast", ctx_->llvm_function);
+    llvm::BasicBlock* slow_bb =
+        llvm::BasicBlock::Create(*ctx_->context, "alloc_slow", ctx_->llvm_function);
+    llvm::BasicBlock* cont_bb =
+        llvm::BasicBlock::Create(*ctx_->context, "alloc_cont", ctx_->llvm_function);
+
+    llvm::MDBuilder md(*ctx_->context);
+    b.CreateCondBr(fits, fast_bb, slow_bb, md.createBranchWeights(2000, 1));
+
+    // Nothing between the bump and the header stores can reach a safepoint, so a collection
+    // never finds the slot half-written.
+    b.SetInsertPoint(fast_bb);
+    b.CreateStore(b.CreateConstInBoundsGEP1_64(i8_ty, cursor, slot), cursor_ptr);
+    b.CreateStore(b.CreateSub(budget, slot_size), budget_ptr);
+    b.CreateStore(llvm::ConstantInt::get(i8_ty, 1),
+                  b.CreateConstInBoundsGEP1_64(i8_ty, cursor, layout.young));
+    b.CreateStore(llvm::ConstantInt::get(i8_ty, 0),
+                  b.CreateConstInBoundsGEP1_64(i8_ty, cursor, layout.remembered));
+    b.CreateStore(llvm::ConstantInt::get(i8_ty, static_cast<uint8_t>(kind)),
+                  b.CreateConstInBoundsGEP1_64(i8_ty, cursor, layout.kind));
+    b.CreateStore(llvm::ConstantInt::get(i8_ty, 0),
+                  b.CreateConstInBoundsGEP1_64(i8_ty, cursor, layout.immortal));
+    emit_init(cursor);
+
+    ValueType tag = kind == gc::GcType::String   ? ValueType::String
+                    : kind == gc::GcType::Struct ? ValueType::Struct
+                                                 : ValueType::Array;
+    b.CreateStore(llvm::ConstantInt::get(i8_ty, static_cast<uint8_t>(tag)),
+                  b.CreateStructGEP(packed_value_ty, res, 0));
+    b.CreateStore(cursor, b.CreateStructGEP(packed_value_ty, res, 2));
+    b.CreateBr(cont_bb);
+
+    b.SetInsertPoint(slow_bb);
+    emit_slow_path();
+    b.CreateBr(cont_bb);
+
+    b.SetInsertPoint(cont_bb);
+    return true;
+}
+
+}  // namespace druk::codegen
+
+#endif  // DRUK_HAVE_LLVM
@@ -10,13 +10,16 @@ namespace druk::codegen
 void LLVMBackend::compile_instruction(ir::Instruction* inst, llvm::StructType* packed_value_ty,
                                       llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty)
 {
+    if (compile_unboxed_op(inst))
+        return;
+
     switch (inst->getOpcode())
     {
         case ir::Opcode::Alloca:
         case ir::Opcode::Store:
         case ir::Opcode::Load:
         {
-            compile_memory_ops(inst, packed_value_ty, i64_ty);
+            compile_memory_ops(inst, packed_value_ty);
             break;
         }
         case ir::Opcode::Add:
@@ -43,6 +46,13 @@ void LLVMBackend::compile_instruction(ir::Instruction* inst, llvm::StructType* p
             compile_array_ops(inst, packed_value_ty, packed_ptr_ty, i64_ty);
             break;
         }
+        case ir::Opcode::BuildStruct:
+        case ir::Opcode::GetField:
+        case ir::Opcode::SetField:
+        {
+            compile_struct_ops(inst, packed_value_ty, packed_ptr_ty, i64_ty);
+            break;
+        }
         case ir::Opcode::Call:
         {
             compile_call_op(inst, packed_ptr_ty);
@@ -0,0 +1,134 @@
+#ifdef DRUK_HAVE_LLVM
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/MDBuilder.h>
+
+#include "druk/codegen/llvm/llvm_backend.h"
+#include "druk/ir/ir_instruction.h"
+
+namespace druk::codegen
+{
+
+namespace
+{
+
+constexpr uint64_t kIntTag  = static_cast<uint64_t>(ValueType::Int);
+constexpr uint64_t kBoolTag = static_cast<uint64_t>(ValueType::Bool);
+
+bool is_int_fast_path_op(ir::Opcode op)
+{
+    switch (op)
+    {
+        case ir::Opcode::Add:
+        case ir::Opcode::Sub:
+        case ir::Opcode::Mul:
+        case ir::Opcode::Div:
+        case ir::Opcode::Equal:
+        case ir::Opcode::NotEqual:
+        case ir::Opcode::LessThan:
+        case ir::Opcode::LessEqual:
+        case ir::Opcode::GreaterThan:
+        case ir::Opcode::GreaterEqual:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+bool LLVMBackend::emit_int_fast_path(ir::Opcode op, llvm::Value* lhs, llvm::Value* rhs,
+                                     llvm::Value* res, llvm::StructType* packed_value_ty,
+                                     llvm::function_ref<void()> emit_slow_path)
+{
+    if (!is_int_fast_path_op(op))
+        return false;
+
+    auto&       b      = *ctx_->builder;
+    llvm::Type* i8_ty  = b.getInt8Ty();
+    llvm::Type* i64_ty = b.getInt64Ty();
+
+    // Both operands must carry the Int tag; anything else takes the runtime helper.
+    llvm::Value* lhs_tag =
+        b.CreateLoad(i8_ty, b.CreateStructGEP(packed_value_ty, lhs, 0), "lhs_tag");
+    llvm::Value* rhs_tag =
+        b.CreateLoad(i8_ty, b.CreateStructGEP(packed_value_ty, rhs, 0), "rhs_tag");
+    llvm::Value* both_int =
+        b.CreateAnd(b.CreateICmpEQ(lhs_tag, llvm::ConstantInt::get(i8_ty, kIntTag)),
+                    b.CreateICmpEQ(rhs_tag, llvm::ConstantInt::get(i8_ty, kIntTag)), "both_int");
+
+    llvm::Value* lhs_i = b.CreateLoad(i64_ty, b.CreateStructGEP(packed_value_ty, lhs, 2), "lhs_i");
+    llvm::Value* rhs_i = b.CreateLoad(i64_ty, b.CreateStructGEP(packed_value_ty, rhs, 2), "rhs_i");
+
+    // Division by zero yields nil, which the helper already handles.
+    if (op == ir::Opcode::Div)
+        both_int = b.CreateAnd(both_int, b.CreateICmpNE(rhs_i, llvm::ConstantInt::get(i64_ty, 0)));
+
+    llvm::BasicBlock* fast_bb =
+        llvm::BasicBlock::Create(*ctx_->context, "int_fast", ctx_->llvm_function);
+    llvm::BasicBlock* slow_bb =
+        llvm::BasicBlock::Create(*ctx_->context, "int_slow", ctx_->llvm_function);
+    llvm::BasicBlock* cont_bb =
+        llvm::BasicBlock::Create(*ctx_->context, "int_cont", ctx_->llvm_function);
+
+    llvm::MDBuilder md(*ctx_->context);
+    b.CreateCondBr(both_int, fast_bb, slow_bb, md.createBranchWeights(2000, 1));
+
+    b.SetInsertPoint(fast_bb);
+    llvm::Value* result = nullptr;
+    uint64_t     tag    = kBoolTag;
+    switch (op)
+    {
+        case ir::Opcode::Add:
+            result = b.CreateAdd(lhs_i, rhs_i, "iadd");
+            tag    = kIntTag;
+            break;
+        case ir::Opcode::Sub:
+            result = b.CreateSub(lhs_i, rhs_i, "isub");
+            tag    = kIntTag;
+            break;
+        case ir::Opcode::Mul:
+            result = b.CreateMul(lhs_i, rhs_i, "imul");
+            tag    = kIntTag;
+            break;
+        case ir::Opcode::Div:
+            result = b.CreateSDiv(lhs_i, rhs_i, "idiv");
+            tag    = kIntTag;
+            break;
+        case ir::Opcode::Equal:
+            result = b.CreateICmpEQ(lhs_i, rhs_i);
+            break;
+        case ir::Opcode::NotEqual:
+            result = b.CreateICmpNE(lhs_i, rhs_i);
+            break;
+        case ir::Opcode::LessThan:
+            result = b.CreateICmpSLT(lhs_i, rhs_i);
+            break;
+        case ir::Opcode::LessEqual:
+            result = b.CreateICmpSLE(lhs_i, rhs_i);
+            break;
+        case ir::Opcode::GreaterThan:
+            result = b.CreateICmpSGT(lhs_i, rhs_i);
+            break;
+        default:
+            result = b.CreateICmpSGE(lhs_i, rhs_i);
+            break;
+    }
+    if (tag == kBoolTag)
+        result = b.CreateZExt(result, i64_ty);
+
+    b.CreateStore(llvm::ConstantInt::get(i8_ty, tag), b.CreateStructGEP(packed_value_ty, res, 0));
+    b.CreateStore(result, b.CreateStructGEP(packed_value_ty, res, 2));
+    b.CreateBr(cont_bb);
+
+    b.SetInsertPoint(slow_bb);
+    emit_slow_path();
+    b.CreateBr(cont_bb);
+
+    b.SetInsertPoint(cont_bb);
+    return true;
+}
+
+}  // namespace druk::codegen
+
+#endif  // DRUK_HAVE_LLVM
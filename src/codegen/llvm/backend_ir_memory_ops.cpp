@@ -9,14 +9,17 @@
 namespace druk::codegen
 {
 
-void LLVMBackend::compile_memory_ops(ir::Instruction* inst, llvm::StructType* packed_value_ty,
-                                     llvm::Type* i64_ty)
+void LLVMBackend::compile_memory_ops(ir::Instruction* inst, llvm::StructType* packed_value_ty)
 {
     switch (inst->getOpcode())
     {
         case ir::Opcode::Alloca:
         {
-            llvm::Value* alloc = create_entry_alloca(packed_value_ty, inst->getName());
+            auto*       slot    = static_cast<ir::AllocaInst*>(inst);
+            llvm::Type* slot_ty = slot->getAllocatedType()->isUnboxed()
+                                      ? get_scalar_type(*slot->getAllocatedType())
+                                      : packed_value_ty;
+            llvm::Value* alloc    = create_entry_alloca(slot_ty, inst->getName());
             ctx_->ir_values[inst] = alloc;
             break;
         }
@@ -25,14 +28,22 @@ void LLVMBackend::compile_memory_ops(ir::Instruction* inst, llvm::StructType* pa
             auto ops = inst->getOperands();
             if (ops.size() < 2)
                 break;
+
+            auto* slot = dynamic_cast<ir::AllocaInst*>(ops[1]);
+            if (slot && slot->getAllocatedType()->isUnboxed())
+            {
+                llvm::Value* scalar = get_scalar_value(ops[0]);
+                llvm::Value* ptr    = get_llvm_value(ops[1]);
+                if (scalar && ptr)
+                    ctx_->builder->CreateStore(scalar, ptr);
+                break;
+            }
+
             llvm::Value* val = get_llvm_value(ops[0]);
             llvm::Value* ptr = get_llvm_value(ops[1]);
 
             if (val && ptr)
-            {
-                ctx_->builder->CreateMemCpy(ptr, llvm::MaybeAlign(8), val, llvm::MaybeAlign(8),
-                                           llvm::ConstantInt::get(i64_ty, 24));
-            }
+                copy_value_pair(val, ptr);
             break;
         }
         case ir::Opcode::Load:
@@ -42,11 +53,16 @@ void LLVMBackend::compile_memory_ops(ir::Instruction* inst, llvm::StructType* pa
                 break;
             llvm::Value* ptr = get_llvm_value(ops[0]);
 
-            if (ptr)
+            auto* slot = dynamic_cast<ir::AllocaInst*>(ops[0]);
+            if (ptr && slot && slot->getAllocatedType()->isUnboxed())
+            {
+                ctx_->ir_scalars[inst] = ctx_->builder->CreateLoad(
+                    get_scalar_type(*slot->getAllocatedType()), ptr);
+            }
+            else if (ptr)
             {
                 llvm::Value* dest = create_entry_alloca(packed_value_ty);
-                ctx_->builder->CreateMemCpy(dest, llvm::MaybeAlign(8), ptr, llvm::MaybeAlign(8),
-                                           llvm::ConstantInt::get(i64_ty, 24));
+                copy_value_pair(ptr, dest);
                 ctx_->ir_values[inst] = dest;
             }
             break;
@@ -0,0 +1,85 @@
+#ifdef DRUK_HAVE_LLVM
+
+#include <llvm/IR/Constants.h>
+
+#include <vector>
+
+#include "druk/codegen/llvm/llvm_backend.h"
+#include "druk/ir/ir_value.h"
+
+namespace druk::codegen
+{
+
+llvm::StructType* LLVMBackend::get_value_pair_type()
+{
+    return llvm::StructType::get(*ctx_->context,
+                                 {ctx_->builder->getInt8Ty(), ctx_->builder->getInt64Ty()});
+}
+
+llvm::FunctionType* LLVMBackend::get_impl_type(size_t param_count)
+{
+    // Each argument is its tag and payload in two registers; the result comes back the same way.
+    std::vector<llvm::Type*> params;
+    for (size_t i = 0; i < param_count; ++i)
+    {
+        params.push_back(ctx_->builder->getInt8Ty());
+        params.push_back(ctx_->builder->getInt64Ty());
+    }
+    return llvm::FunctionType::get(get_value_pair_type(), params, false);
+}
+
+llvm::Value* LLVMBackend::make_value_pair(llvm::Value* tag, llvm::Value* payload)
+{
+    auto&        b    = *ctx_->builder;
+    llvm::Value* pair = b.CreateInsertValue(llvm::UndefValue::get(get_value_pair_type()), tag, 0);
+    return b.CreateInsertValue(pair, payload, 1);
+}
+
+llvm::Value* LLVMBackend::load_value_pair(llvm::Value* packed)
+{
+    auto&             b               = *ctx_->builder;
+    llvm::StructType* packed_value_ty = get_packed_value_type();
+    llvm::Value*      tag =
+        b.CreateLoad(b.getInt8Ty(), b.CreateStructGEP(packed_value_ty, packed, 0), "tag");
+    llvm::Value* payload =
+        b.CreateLoad(b.getInt64Ty(), b.CreateStructGEP(packed_value_ty, packed, 2), "payload");
+    return make_value_pair(tag, payload);
+}
+
+llvm::Value* LLVMBackend::get_value_pair(ir::Value* value)
+{
+    auto& b = *ctx_->builder;
+
+    // Statically int/bool values travel without a box: the tag is a constant.
+    if (value->getType()->isUnboxed())
+    {
+        llvm::Value* scalar = get_scalar_value(value);
+        if (!scalar)
+            return nullptr;
+        auto tag = value->getType()->getID() == ir::TypeID::Bool ? ValueType::Bool : ValueType::Int;
+        return make_value_pair(b.getInt8(static_cast<uint8_t>(tag)),
+                               b.CreateZExt(scalar, b.getInt64Ty()));
+    }
+
+    llvm::Value* packed = get_llvm_value(value);
+    return packed ? load_value_pair(packed) : nullptr;
+}
+
+void LLVMBackend::store_value_pair(llvm::Value* pair, llvm::Value* packed)
+{
+    auto&             b               = *ctx_->builder;
+    llvm::StructType* packed_value_ty = get_packed_value_type();
+    b.CreateStore(b.CreateExtractValue(pair, 0), b.CreateStructGEP(packed_value_ty, packed, 0));
+    b.CreateStore(b.CreateExtractValue(pair, 1), b.CreateStructGEP(packed_value_ty, packed, 2));
+}
+
+void LLVMBackend::copy_value_pair(llvm::Value* from, llvm::Value* to)
+{
+    // Field by field rather than a 16-byte memcpy: most values were just written as two fields,
+    // and a wide load of them cannot be forwarded from the stores (the loads usually fold away).
+    store_value_pair(load_value_pair(from), to);
+}
+
+}  // namespace druk::codegen
+
+#endif  // DRUK_HAVE_LLVM
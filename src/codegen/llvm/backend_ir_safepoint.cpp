@@ -0,0 +1,62 @@
+#ifdef DRUK_HAVE_LLVM
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/MDBuilder.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "druk/codegen/llvm/llvm_backend.h"
+#include "druk/gc/gc_heap.h"
+
+namespace druk::codegen
+{
+
+// The poll reads the flag as a byte.
+static_assert(sizeof(std::atomic<bool>) == 1 && std::atomic<bool>::is_always_lock_free);
+
+void LLVMBackend::emit_safepoint_poll(llvm::IRBuilder<>& builder, llvm::BasicBlock* next)
+{
+    llvm::Type* i8_ty  = builder.getInt8Ty();
+    llvm::Type* ptr_ty = llvm::PointerType::getUnqual(*ctx_->context);
+
+    // The heap lives as long as the process, so JIT code refers to its flag by address.
+    llvm::Constant* flag = llvm::ConstantExpr::getIntToPtr(
+        builder.getInt64(reinterpret_cast<uintptr_t>(&gc::GcHeap::get().safepointRequested())),
+        ptr_ty);
+    llvm::LoadInst* requested = builder.CreateLoad(i8_ty, flag, "safepoint_requested");
+    requested->setAtomic(llvm::AtomicOrdering::Monotonic);
+    requested->setAlignment(llvm::Align(1));
+
+    llvm::BasicBlock* pollBB =
+        llvm::BasicBlock::Create(*ctx_->context, "safepoint", ctx_->llvm_function);
+    llvm::MDBuilder md(*ctx_->context);
+    builder.CreateCondBr(builder.CreateICmpNE(requested, builder.getInt8(0)), pollBB, next,
+                         md.createBranchWeights(1, 2000));
+
+    // Every frame slot is registered by now and nothing is held outside them, like the VM's
+    // stack at its safepoints.
+    llvm::IRBuilder<> poll(pollBB);
+    poll.CreateCall(ctx_->module->getOrInsertFunction(
+        "druk_jit_safepoint", llvm::FunctionType::get(poll.getVoidTy(), false)));
+    poll.CreateBr(next);
+}
+
+llvm::BasicBlock* LLVMBackend::branch_target(ir::BasicBlock* dest)
+{
+    llvm::BasicBlock* target = ctx_->ir_blocks[dest];
+    // Blocks are compiled in order and a loop's header comes before its body, so a target that
+    // already holds code is behind the branch: the branch closes a loop.
+    if (!safepoint_polls_ || target->empty())
+        return target;
+
+    llvm::BasicBlock* latch =
+        llvm::BasicBlock::Create(*ctx_->context, "loop_latch", ctx_->llvm_function);
+    llvm::IRBuilder<> builder(latch);
+    emit_safepoint_poll(builder, target);
+    return latch;
+}
+
+}  // namespace druk::codegen
+
+#endif  // DRUK_HAVE_LLVM
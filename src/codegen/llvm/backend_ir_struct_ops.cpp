@@ -0,0 +1,233 @@
+#ifdef DRUK_HAVE_LLVM
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/MDBuilder.h>
+
+#include <cstdint>
+#include <string>
+
+#include "druk/codegen/llvm/llvm_backend.h"
+#include "druk/gc/gc_layout.h"
+#include "druk/gc/types/gc_struct.h"
+#include "druk/ir/ir_instruction.h"
+
+namespace druk::codegen
+{
+
+namespace
+{
+
+// `text` as private module data, without a terminator.
+llvm::GlobalVariable* emit_bytes(llvm::Module& module, const std::string& text)
+{
+    llvm::Constant* data = llvm::ConstantDataArray::getString(module.getContext(), text, false);
+    return new llvm::GlobalVariable(module, data->getType(), true,
+                                    llvm::GlobalValue::PrivateLinkage, data, ".field");
+}
+
+}  // namespace
+
+void LLVMBackend::compile_struct_ops(ir::Instruction* inst, llvm::StructType* packed_value_ty,
+                                     llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty)
+{
+    switch (inst->getOpcode())
+    {
+        case ir::Opcode::BuildStruct:
+            compile_struct_build(inst, packed_value_ty, packed_ptr_ty, i64_ty);
+            break;
+        case ir::Opcode::GetField:
+        case ir::Opcode::SetField:
+            compile_field_access(inst, packed_value_ty, packed_ptr_ty, i64_ty);
+            break;
+        default:
+            break;
+    }
+}
+
+void LLVMBackend::compile_struct_build(ir::Instruction* inst, llvm::StructType* packed_value_ty,
+                                       llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty)
+{
+    auto*              build = static_cast<ir::BuildStructInst*>(inst);
+    const gc::GcShape* shape = build->getShape();
+    auto               ops   = inst->getOperands();
+    size_t             count = ops.size();
+
+    auto&            b        = *ctx_->builder;
+    llvm::ArrayType* array_ty = llvm::ArrayType::get(packed_value_ty, count == 0 ? 1 : count);
+    llvm::Value*     values   = create_entry_alloca(array_ty, "struct_fields");
+    for (size_t i = 0; i < count; ++i)
+    {
+        llvm::Value* field = get_llvm_value(ops[i]);
+        if (!field)
+            return;
+        copy_value_pair(field, b.CreateConstInBoundsGEP2_64(array_ty, values, 0, i));
+    }
+
+    llvm::Value* first   = b.CreateConstInBoundsGEP2_64(array_ty, values, 0, 0);
+    llvm::Value* res     = create_entry_alloca(packed_value_ty);
+    llvm::Type*  i32_ty  = b.getInt32Ty();
+    llvm::Type*  void_ty = b.getVoidTy();
+
+    if (!inline_shapes_)
+    {
+        // Without a shape to point at, the runtime rebuilds it from the field names.
+        std::string names;
+        for (const auto& name : shape->names()) names += name + '\0';
+        b.CreateCall(ctx_->module->getOrInsertFunction(
+                         "druk_jit_build_struct",
+                         llvm::FunctionType::get(void_ty,
+                                                 {packed_ptr_ty, packed_ptr_ty, i32_ty,
+                                                  packed_ptr_ty},
+                                                 false)),
+                     {emit_bytes(*ctx_->module, names), first,
+                      llvm::ConstantInt::get(i32_ty, count), res});
+        ctx_->ir_values[inst] = res;
+        return;
+    }
+
+    // Shapes are never freed, so the one the literal was given at compile time is referred to
+    // by address.
+    llvm::Constant* shape_ptr = llvm::ConstantExpr::getIntToPtr(
+        llvm::ConstantInt::get(i64_ty, reinterpret_cast<uintptr_t>(shape)), packed_ptr_ty);
+
+    auto emit_new_call = [&]
+    {
+        b.CreateCall(ctx_->module->getOrInsertFunction(
+                         "druk_jit_new_struct",
+                         llvm::FunctionType::get(void_ty, {packed_ptr_ty, packed_ptr_ty,
+                                                           packed_ptr_ty},
+                                                 false)),
+                     {shape_ptr, first, res});
+    };
+
+    // Like an inline array: the fields go straight into the struct's inline storage.
+    auto emit_init = [&](llvm::Value* obj)
+    {
+        llvm::Type*               i8_ty   = b.getInt8Ty();
+        const gc::GcObjectLayout& layout  = gc::GcObjectLayout::get();
+        llvm::Value*              storage = b.CreateConstInBoundsGEP1_64(i8_ty, obj,
+                                                                         layout.structInline);
+        b.CreateStore(shape_ptr, b.CreateConstInBoundsGEP1_64(i8_ty, obj, layout.structShape));
+        b.CreateStore(storage, b.CreateConstInBoundsGEP1_64(i8_ty, obj, layout.structData));
+        b.CreateStore(llvm::ConstantInt::get(i64_ty, count),
+                      b.CreateConstInBoundsGEP1_64(i8_ty, obj, layout.structSize));
+        b.CreateStore(llvm::ConstantInt::get(i64_ty, gc::GcArrayElements::kInlineCapacity),
+                      b.CreateConstInBoundsGEP1_64(i8_ty, obj, layout.structCapacity));
+        if (count > 0)
+            b.CreateMemCpy(storage, llvm::MaybeAlign(8), first, llvm::MaybeAlign(8),
+                           count * sizeof(PackedValue));
+    };
+
+    if (count > gc::GcArrayElements::kInlineCapacity ||
+        !emit_inline_alloc(sizeof(gc::GcStruct), gc::GcType::Struct, res, packed_value_ty,
+                           emit_init, emit_new_call))
+        emit_new_call();
+
+    ctx_->ir_values[inst] = res;
+}
+
+void LLVMBackend::compile_field_access(ir::Instruction* inst, llvm::StructType* packed_value_ty,
+                                       llvm::PointerType* packed_ptr_ty, llvm::Type* i64_ty)
+{
+    bool               is_get = inst->getOpcode() == ir::Opcode::GetField;
+    const std::string& field  = is_get ? static_cast<ir::GetFieldInst*>(inst)->getField()
+                                       : static_cast<ir::SetFieldInst*>(inst)->getField();
+    llvm::Value*       object = get_llvm_value(inst->getOperand(0));
+    llvm::Value*       value  = is_get ? nullptr : get_llvm_value(inst->getOperand(1));
+    if (!object || (!is_get && !value))
+        return;
+
+    auto&             b        = *ctx_->builder;
+    llvm::StructType* entry_ty = llvm::StructType::get(packed_ptr_ty, i64_ty);
+    llvm::ArrayType*  cache_ty = llvm::ArrayType::get(entry_ty, kDrukFieldCacheSize);
+    auto*             cache    = new llvm::GlobalVariable(
+        *ctx_->module, cache_ty, false, llvm::GlobalValue::PrivateLinkage,
+        llvm::ConstantAggregateZero::get(cache_ty), "field_cache");
+    cache->setAlignment(llvm::Align(alignof(DrukFieldCache)));
+
+    llvm::Value* name     = emit_bytes(*ctx_->module, field);
+    llvm::Value* name_len = llvm::ConstantInt::get(i64_ty, field.size());
+    llvm::Value* res      = is_get ? create_entry_alloca(packed_value_ty) : nullptr;
+
+    auto emit_runtime_call = [&]
+    {
+        b.CreateCall(ctx_->module->getOrInsertFunction(
+                         is_get ? "druk_jit_get_field_cached" : "druk_jit_set_field_cached",
+                         llvm::FunctionType::get(b.getVoidTy(),
+                                                 {packed_ptr_ty, packed_ptr_ty, packed_ptr_ty,
+                                                  i64_ty, packed_ptr_ty},
+                                                 false)),
+                     {cache, object, name, name_len, is_get ? res : value});
+    };
+
+    // Stores stay in the runtime, which owns the write barrier and adds missing fields; it
+    // still skips the name lookup once the cache has seen the struct's shape.
+    if (!is_get || !inline_shapes_)
+    {
+        emit_runtime_call();
+        if (is_get)
+            ctx_->ir_values[inst] = res;
+        return;
+    }
+
+    // A read of a struct whose shape the cache has seen is two loads, with no call.
+    llvm::Function*   fn      = b.GetInsertBlock()->getParent();
+    llvm::BasicBlock* checkBB = llvm::BasicBlock::Create(*ctx_->context, "field_check", fn);
+    llvm::BasicBlock* hitBB   = llvm::BasicBlock::Create(*ctx_->context, "field_hit", fn);
+    llvm::BasicBlock* missBB  = llvm::BasicBlock::Create(*ctx_->context, "field_miss", fn);
+    llvm::BasicBlock* contBB  = llvm::BasicBlock::Create(*ctx_->context, "field_cont", fn);
+    llvm::MDBuilder   md(*ctx_->context);
+
+    llvm::Value* pair     = load_value_pair(object);
+    llvm::Value* isStruct = b.CreateICmpEQ(b.CreateExtractValue(pair, 0),
+                                           b.getInt8(static_cast<uint8_t>(ValueType::Struct)));
+    b.CreateCondBr(isStruct, checkBB, missBB, md.createBranchWeights(2000, 1));
+
+    b.SetInsertPoint(checkBB);
+    llvm::Type*               i8_ty  = b.getInt8Ty();
+    const gc::GcObjectLayout& layout = gc::GcObjectLayout::get();
+    llvm::Value* obj   = b.CreateIntToPtr(b.CreateExtractValue(pair, 1), packed_ptr_ty);
+    llvm::Value* shape = b.CreateLoad(
+        packed_ptr_ty, b.CreateConstInBoundsGEP1_64(i8_ty, obj, layout.structShape), "shape");
+    // Empty entries hold no shape, and a struct always has one, so they never match. Another
+    // thread may be filling an entry: its shape is loaded with acquire, so a match sees the slot
+    // stored before it.
+    llvm::Value* slot = b.getInt64(0);
+    llvm::Value* hit  = b.getFalse();
+    for (uint32_t i = kDrukFieldCacheSize; i-- > 0;)
+    {
+        auto entry_field = [&](uint32_t f, llvm::Type* ty, llvm::AtomicOrdering ordering)
+        {
+            llvm::LoadInst* load =
+                b.CreateLoad(ty, b.CreateInBoundsGEP(cache_ty, cache,
+                                                     {b.getInt32(0), b.getInt32(i),
+                                                      b.getInt32(f)}));
+            load->setAtomic(ordering);
+            load->setAlignment(llvm::Align(8));
+            return load;
+        };
+        llvm::Value* matches =
+            b.CreateICmpEQ(entry_field(0, packed_ptr_ty, llvm::AtomicOrdering::Acquire), shape);
+        slot = b.CreateSelect(matches, entry_field(1, i64_ty, llvm::AtomicOrdering::Monotonic),
+                              slot);
+        hit  = b.CreateOr(hit, matches);
+    }
+    b.CreateCondBr(hit, hitBB, missBB, md.createBranchWeights(2000, 1));
+
+    b.SetInsertPoint(hitBB);
+    llvm::Value* data = b.CreateLoad(
+        packed_ptr_ty, b.CreateConstInBoundsGEP1_64(i8_ty, obj, layout.structData), "fields");
+    copy_value_pair(b.CreateInBoundsGEP(packed_value_ty, data, slot), res);
+    b.CreateBr(contBB);
+
+    b.SetInsertPoint(missBB);
+    emit_runtime_call();
+    b.CreateBr(contBB);
+
+    b.SetInsertPoint(contBB);
+    ctx_->ir_values[inst] = res;
+}
+
+}  // namespace druk::codegen
+
+#endif  // DRUK_HAVE_LLVM
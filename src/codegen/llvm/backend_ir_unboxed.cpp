@@ -0,0 +1,140 @@
+#ifdef DRUK_HAVE_LLVM
+
+#include <llvm/IR/Constants.h>
+
+#include "druk/codegen/llvm/llvm_backend.h"
+#include "druk/ir/ir_instruction.h"
+#include "druk/ir/ir_value.h"
+
+namespace druk::codegen
+{
+
+llvm::Type* LLVMBackend::get_scalar_type(const ir::Type& type)
+{
+    if (type.getID() == ir::TypeID::Bool)
+        return ctx_->builder->getInt1Ty();
+    return ctx_->builder->getInt64Ty();
+}
+
+llvm::Value* LLVMBackend::get_scalar_value(ir::Value* value)
+{
+    auto& b = *ctx_->builder;
+    if (auto* cInt = dynamic_cast<ir::ConstantInt*>(value))
+        return b.getInt64(static_cast<uint64_t>(cInt->getValue()));
+    if (auto* cBool = dynamic_cast<ir::ConstantBool*>(value))
+        return b.getInt1(cBool->getValue());
+
+    auto it = ctx_->ir_scalars.find(value);
+    if (it != ctx_->ir_scalars.end())
+        return it->second;
+
+    // Statically typed, but only materialized boxed (e.g. an unwrapped value): read the payload.
+    llvm::Value* boxed = get_llvm_value(value);
+    if (!boxed)
+        return nullptr;
+    llvm::Value* data = b.CreateLoad(b.getInt64Ty(), b.CreateStructGEP(get_packed_value_type(),
+                                                                       boxed, 2));
+    if (value->getType()->getID() == ir::TypeID::Bool)
+        return b.CreateICmpNE(data, b.getInt64(0));
+    return data;
+}
+
+llvm::Value* LLVMBackend::box_scalar(llvm::Value* scalar, ir::TypeID type)
+{
+    auto&             b               = *ctx_->builder;
+    llvm::StructType* packed_value_ty = get_packed_value_type();
+    llvm::Value*      alloc           = create_entry_alloca(packed_value_ty, "boxed");
+
+    auto tag = type == ir::TypeID::Bool ? ValueType::Bool : ValueType::Int;
+    b.CreateStore(b.getInt8(static_cast<uint8_t>(tag)),
+                  b.CreateStructGEP(packed_value_ty, alloc, 0));
+    b.CreateStore(b.CreateZExt(scalar, b.getInt64Ty()),
+                  b.CreateStructGEP(packed_value_ty, alloc, 2));
+    return alloc;
+}
+
+bool LLVMBackend::compile_unboxed_op(ir::Instruction* inst)
+{
+    // Only instructions whose IR type is statically int/bool are lowered natively; everything
+    // else goes through the boxed PackedValue path.
+    if (!inst->getType()->isUnboxed())
+        return false;
+
+    auto& b = *ctx_->builder;
+    switch (inst->getOpcode())
+    {
+        case ir::Opcode::Neg:
+        case ir::Opcode::Not:
+        {
+            llvm::Value* val = get_scalar_value(inst->getOperand(0));
+            if (!val)
+                return false;
+            ctx_->ir_scalars[inst] =
+                inst->getOpcode() == ir::Opcode::Neg ? b.CreateNeg(val) : b.CreateNot(val);
+            return true;
+        }
+        case ir::Opcode::Add:
+        case ir::Opcode::Sub:
+        case ir::Opcode::Mul:
+        case ir::Opcode::Equal:
+        case ir::Opcode::NotEqual:
+        case ir::Opcode::LessThan:
+        case ir::Opcode::LessEqual:
+        case ir::Opcode::GreaterThan:
+        case ir::Opcode::GreaterEqual:
+        case ir::Opcode::And:
+        case ir::Opcode::Or:
+            break;
+        default:
+            return false;
+    }
+
+    llvm::Value* lhs = get_scalar_value(inst->getOperand(0));
+    llvm::Value* rhs = get_scalar_value(inst->getOperand(1));
+    if (!lhs || !rhs)
+        return false;
+
+    llvm::Value* result = nullptr;
+    switch (inst->getOpcode())
+    {
+        case ir::Opcode::Add:
+            result = b.CreateAdd(lhs, rhs);
+            break;
+        case ir::Opcode::Sub:
+            result = b.CreateSub(lhs, rhs);
+            break;
+        case ir::Opcode::Mul:
+            result = b.CreateMul(lhs, rhs);
+            break;
+        case ir::Opcode::Equal:
+            result = b.CreateICmpEQ(lhs, rhs);
+            break;
+        case ir::Opcode::NotEqual:
+            result = b.CreateICmpNE(lhs, rhs);
+            break;
+        case ir::Opcode::LessThan:
+            result = b.CreateICmpSLT(lhs, rhs);
+            break;
+        case ir::Opcode::LessEqual:
+            result = b.CreateICmpSLE(lhs, rhs);
+            break;
+        case ir::Opcode::GreaterThan:
+            result = b.CreateICmpSGT(lhs, rhs);
+            break;
+        case ir::Opcode::GreaterEqual:
+            result = b.CreateICmpSGE(lhs, rhs);
+            break;
+        case ir::Opcode::And:
+            result = b.CreateAnd(lhs, rhs);
+            break;
+        default:
+            result = b.CreateOr(lhs, rhs);
+            break;
+    }
+    ctx_->ir_scalars[inst] = result;
+    return true;
+}
+
+}  // namespace druk::codegen
+
+#endif  // DRUK_HAVE_LLVM
@@ -31,7 +31,7 @@ extern "C"
     void druk_jit_index(const PackedValue* arr_val, const PackedValue* idx_val, PackedValue* out);
     void druk_jit_index_set(PackedValue* arr_val, const PackedValue* idx_val,
                             const PackedValue* val);
-    void druk_jit_build_struct(const PackedValue* keys, const PackedValue* values, int32_t count,
+    void druk_jit_build_struct(const char* names, const PackedValue* values, int32_t count,
                                PackedValue* out);
     void druk_jit_get_field(const PackedValue* struct_val, const char* field, size_t field_len,
                             PackedValue* out);
@@ -49,6 +49,8 @@ extern "C"
     void druk_jit_call(const PackedValue* callee, const PackedValue* args, int32_t arg_count,
                        PackedValue* out);
     void druk_jit_get_arg(int32_t index, PackedValue* out);
+    void druk_jit_call_cached(DrukCallCache* cache, const PackedValue* callee,
+                              const PackedValue* args, int32_t arg_count, PackedValue* out);
     void druk_jit_register_function(druk::codegen::ObjFunction* function,
                                     void (*fn)(PackedValue* out));
     void druk_jit_set_compile_handler(DrukJitCompileFn fn);
@@ -59,6 +61,10 @@ extern "C"
     int64_t druk_jit_value_as_int(const PackedValue* value);
     int32_t druk_jit_value_as_bool_int(const PackedValue* value);
     void    druk_jit_panic_unwrap();
+    void    druk_jit_push_roots(PackedValue* slots, int32_t count);
+    void    druk_jit_pop_roots();
+    void*   druk_jit_alloc_buffer();
+    void    druk_jit_safepoint();
 }
 
 namespace druk::codegen
@@ -145,6 +151,8 @@ void LLVMBackend::register_runtime_symbols()
                                              llvm::JITSymbolFlags::Exported};
     symbols[mangle("druk_jit_get_arg")]   = {llvm::orc::ExecutorAddr::fromPtr(&druk_jit_get_arg),
                                              llvm::JITSymbolFlags::Exported};
+    symbols[mangle("druk_jit_call_cached")] = {
+        llvm::orc::ExecutorAddr::fromPtr(&druk_jit_call_cached), llvm::JITSymbolFlags::Exported};
     symbols[mangle("druk_jit_register_function")] = {
         llvm::orc::ExecutorAddr::fromPtr(&druk_jit_register_function),
         llvm::JITSymbolFlags::Exported};
@@ -167,6 +175,16 @@ void LLVMBackend::register_runtime_symbols()
         llvm::JITSymbolFlags::Exported};
     symbols[mangle("druk_jit_panic_unwrap")] = {
         llvm::orc::ExecutorAddr::fromPtr(&druk_jit_panic_unwrap), llvm::JITSymbolFlags::Exported};
+    symbols[mangle("druk_jit_push_roots")] = {
+        llvm::orc::ExecutorAddr::fromPtr(&druk_jit_push_roots), llvm::JITSymbolFlags::Exported};
+    symbols[mangle("druk_jit_pop_roots")] = {llvm::orc::ExecutorAddr::fromPtr(&druk_jit_pop_roots),
+                                             llvm::JITSymbolFlags::Exported};
+    symbols[mangle("druk_jit_set_alloc_site")] = {
+        llvm::orc::ExecutorAddr::fromPtr(&druk_jit_set_alloc_site), llvm::JITSymbolFlags::Exported};
+    symbols[mangle("druk_jit_alloc_buffer")] = {
+        llvm::orc::ExecutorAddr::fromPtr(&druk_jit_alloc_buffer), llvm::JITSymbolFlags::Exported};
+    symbols[mangle("druk_jit_safepoint")] = {llvm::orc::ExecutorAddr::fromPtr(&druk_jit_safepoint),
+                                             llvm::JITSymbolFlags::Exported};
 
     llvm::cantFail(jd.define(llvm::orc::absoluteSymbols(std::move(symbols))));
 }
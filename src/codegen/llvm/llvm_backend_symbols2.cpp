@@ -10,7 +10,7 @@ extern "C"
     void druk_jit_index(const PackedValue* arr_val, const PackedValue* idx_val, PackedValue* out);
     void druk_jit_index_set(PackedValue* arr_val, const PackedValue* idx_val,
                             const PackedValue* val);
-    void druk_jit_build_struct(const PackedValue* keys, const PackedValue* values, int32_t count,
+    void druk_jit_build_struct(const char* names, const PackedValue* values, int32_t count,
                                PackedValue* out);
     void druk_jit_get_field(const PackedValue* struct_val, const char* field, size_t field_len,
                             PackedValue* out);
@@ -54,6 +54,14 @@ void LLVMBackend::register_extended_symbols()
                                              llvm::JITSymbolFlags::Exported};
     symbols[mangle("druk_jit_set_field")] = {llvm::orc::ExecutorAddr::fromPtr(&druk_jit_set_field),
                                              llvm::JITSymbolFlags::Exported};
+    symbols[mangle("druk_jit_new_struct")] = {
+        llvm::orc::ExecutorAddr::fromPtr(&druk_jit_new_struct), llvm::JITSymbolFlags::Exported};
+    symbols[mangle("druk_jit_get_field_cached")] = {
+        llvm::orc::ExecutorAddr::fromPtr(&druk_jit_get_field_cached),
+        llvm::JITSymbolFlags::Exported};
+    symbols[mangle("druk_jit_set_field_cached")] = {
+        llvm::orc::ExecutorAddr::fromPtr(&druk_jit_set_field_cached),
+        llvm::JITSymbolFlags::Exported};
     symbols[mangle("druk_jit_len")]       = {llvm::orc::ExecutorAddr::fromPtr(&druk_jit_len),
                                              llvm::JITSymbolFlags::Exported};
     symbols[mangle("druk_jit_push")]      = {llvm::orc::ExecutorAddr::fromPtr(&druk_jit_push),
@@ -25,6 +25,14 @@ void LLVMBackend::optimize_module()
     pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3).run(*ctx_->module, mam);
 }
 
+llvm::StructType* LLVMBackend::get_packed_value_type()
+{
+    llvm::Type* i8_ty  = llvm::Type::getInt8Ty(*ctx_->context);
+    llvm::Type* i64_ty = llvm::Type::getInt64Ty(*ctx_->context);
+    return llvm::StructType::get(*ctx_->context, {i8_ty, llvm::ArrayType::get(i8_ty, 7), i64_ty},
+                                 false);
+}
+
 llvm::Value* LLVMBackend::create_entry_alloca(llvm::Type* type, const std::string& name)
 {
     llvm::BasicBlock& entry = ctx_->llvm_function->getEntryBlock();
@@ -7,6 +7,7 @@
 
 #include "druk/codegen/jit/jit_runtime.h"
 #include "druk/codegen/llvm/llvm_backend.h"
+#include "druk/gc/gc_mutator.h"
 
 namespace druk::codegen
 {
@@ -61,7 +62,10 @@ std::optional<int64_t> JITEngine::execute(ir::Function* function)
     stats_.totalCompileTimeMs += compileTime;
 
     PackedValue result{};
-    compiled(&result);
+    {
+        gc::GcMutatorScope mutator;
+        compiled(&result);
+    }
     // For now, return 0 if void, or int if possible. The signature is void(PackedValue*).
     // result should be populated by the function.
     return druk_jit_value_as_int(&result);
@@ -32,7 +32,7 @@ extern "C"
     void druk_jit_index(const PackedValue* arr_val, const PackedValue* idx_val, PackedValue* out);
     void druk_jit_index_set(PackedValue* arr_val, const PackedValue* idx_val,
                             const PackedValue* val);
-    void druk_jit_build_struct(const PackedValue* keys, const PackedValue* values, int32_t count,
+    void druk_jit_build_struct(const char* names, const PackedValue* values, int32_t count,
                                PackedValue* out);
     void druk_jit_get_field(const PackedValue* struct_val, const char* field, size_t field_len,
                             PackedValue* out);
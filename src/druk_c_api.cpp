@@ -1,6 +1,9 @@
 // C API wrapper for embedding Druk in standalone executables
 #include <cstring>
+#include <iostream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "druk/codegen/core/chunk.h"
@@ -14,6 +17,26 @@ using namespace druk;
 using namespace druk::codegen;
 using namespace druk::vm;
 
+namespace
+{
+
+void traceChunk(void* chunk)
+{
+    for (const Value& constant : static_cast<Chunk*>(chunk)->constants()) constant.markGcRefs();
+}
+
+void updateChunk(void* chunk)
+{
+    for (Value& constant : static_cast<Chunk*>(chunk)->constants()) constant.updateGcRefs();
+}
+
+void traceFunction(void* func)
+{
+    gc::GcHeap::get().markObject(static_cast<ObjFunction*>(func));
+}
+
+}  // namespace
+
 extern "C"
 {
     void* druk_chunk_create()
@@ -63,6 +86,7 @@ extern "C"
         auto* func_ptr  = static_cast<ObjFunction*>(func);
         auto* chunk_ptr = static_cast<Chunk*>(chunk);
         func_ptr->chunk = *chunk_ptr;
+        func_ptr->chunk.resolveGlobals();
     }
 
     void druk_function_set_name(void* func, const char* name)
@@ -95,6 +119,58 @@ extern "C"
         delete static_cast<ObjFunction*>(func);
     }
 
+    // Keeps a function's constants alive while the host holds it outside a running VM.
+    void* druk_gc_root_function(void* func)
+    {
+        return new gc::GcRootHandle(gc::GcHeap::get().roots().addCallback(traceFunction, func));
+    }
+
+    void druk_gc_release_root(void* root)
+    {
+        delete static_cast<gc::GcRootHandle*>(root);
+    }
+
+    // Looks up one GcStats field by name, e.g. "full_collections", "max_pause_us" or
+    // "live_bytes.string". Unknown names read as 0.
+    uint64_t druk_gc_stat(const char* name)
+    {
+        gc::GcStats      stats = gc::GcHeap::get().stats();
+        std::string_view key   = name ? name : "";
+        for (size_t i = 0; i < gc::kGcTypeCount; ++i)
+        {
+            std::string type = gc::gcTypeName(static_cast<gc::GcType>(i));
+            if (key == "live_objects." + type)
+                return stats.liveObjectsByType[i];
+            if (key == "live_bytes." + type)
+                return stats.liveBytesByType[i];
+        }
+        const std::pair<std::string_view, uint64_t> fields[] = {
+            {"minor_collections", stats.minorCollections},
+            {"full_collections", stats.fullCollections},
+            {"mark_increments", stats.markIncrements},
+            {"pauses", stats.pauses},
+            {"total_pause_us", stats.totalPauseUs},
+            {"max_pause_us", stats.maxPauseUs},
+            {"bytes_allocated", stats.bytesAllocated},
+            {"bytes_freed", stats.bytesFreed},
+            {"objects_freed", stats.objectsFreed},
+            {"compactions", stats.compactions},
+            {"objects_moved", stats.objectsMoved},
+            {"live_objects", stats.liveObjects},
+            {"live_bytes", stats.liveBytes},
+            {"committed_bytes", stats.committedBytes},
+        };
+        for (const auto& [field, value] : fields)
+            if (key == field)
+                return value;
+        return 0;
+    }
+
+    void druk_gc_print_stats()
+    {
+        gc::GcHeap::get().stats().print(std::cerr);
+    }
+
     size_t druk_chunk_serialize_size(void* chunk)
     {
         auto        chunk_ptr = static_cast<Chunk*>(chunk);
@@ -203,6 +279,9 @@ extern "C"
             return;
         ptr += 4;
 
+        // Each string constant allocates, so the ones already loaded must survive a collection.
+        auto roots = gc::GcHeap::get().roots().addCallback(traceChunk, chunk_ptr, updateChunk);
+
         uint32_t code_size, constants_size, lines_size;
         memcpy(&code_size, ptr, 4);
         ptr += 4;
@@ -226,8 +305,8 @@ extern "C"
                 uint32_t str_size;
                 memcpy(&str_size, ptr, 4);
                 ptr += 4;
-                auto* gs =
-                    gc::GcHeap::get().alloc<gc::GcString>(std::string((const char*)ptr, str_size));
+                auto* gs = gc::GcHeap::get().allocString(
+                    std::string_view(reinterpret_cast<const char*>(ptr), str_size));
                 ptr += str_size;
                 chunk_ptr->addConstant(Value(gs));
             }
@@ -251,6 +330,7 @@ extern "C"
                 chunk_ptr->addConstant(Value());
             }
         }
+        chunk_ptr->resolveGlobals();
     }
 
 }  // extern "C"
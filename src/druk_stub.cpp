@@ -23,6 +23,8 @@ extern "C" {
   void druk_function_set_chunk(void* func, void* chunk);
   void druk_function_set_name(void* func, const char* name);
   int druk_vm_interpret(void* vm, void* func);
+  void* druk_gc_root_function(void* func);
+  void druk_gc_release_root(void* root);
 }
 
 // Marqueur magique pour identifier le bytecode embarqué
@@ -125,6 +127,8 @@ int main(int argc, char** argv) {
     void* func = druk_function_create();
     druk_function_set_chunk(func, chunk);
     druk_function_set_name(func, "script");
+    // Garder les constantes en vie pendant que set_args alloue
+    void* root = druk_gc_root_function(func);
 
     // Exécuter
     void* vm = druk_vm_create();
@@ -132,6 +136,7 @@ int main(int argc, char** argv) {
     int result = druk_vm_interpret(vm, func);
 
     // Cleanup
+    druk_gc_release_root(root);
     druk_vm_destroy(vm);
     druk_function_destroy(func);
     druk_chunk_destroy(chunk);
@@ -1,19 +1,39 @@
 #include "druk/gc/types/gc_array.h"
 
-#include "druk/codegen/core/value.h"
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
 
-namespace druk
+namespace druk::gc
 {
-namespace gc
+
+GcArrayElements::GcArrayElements(GcArrayElements&& other) noexcept
+    : size_(other.size_), capacity_(other.capacity_)
 {
+    if (other.spilled())
+        data_ = std::exchange(other.data_, other.inlineData());
+    else
+        std::uninitialized_copy(other.data_, other.data_ + size_, data_);
+    other.size_     = 0;
+    other.capacity_ = kInlineCapacity;
+}
 
-GcArray::GcArray() : GcObject(GcType::Array) {}
-GcArray::~GcArray() = default;
+GcArrayElements::~GcArrayElements()
+{
+    if (spilled())
+        ::operator delete(data_);
+}
 
-void GcArray::trace()
+void GcArrayElements::grow(size_t minCapacity)
 {
-    for (auto& elem : elements) elem.markGcRefs();
+    size_t capacity = std::max(minCapacity, capacity_ * 2);
+    auto*  data     = static_cast<Value*>(::operator new(capacity * sizeof(Value)));
+    std::uninitialized_copy(data_, data_ + size_, data);
+    if (spilled())
+        ::operator delete(data_);
+    data_     = data;
+    capacity_ = capacity;
 }
 
-}  // namespace gc
-}  // namespace druk
+}  // namespace druk::gc
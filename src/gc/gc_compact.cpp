@@ -0,0 +1,58 @@
+#include <cstdint>
+
+#include "druk/codegen/core/obj.h"
+#include "druk/codegen/core/value.h"
+#include "druk/gc/gc_heap.h"
+#include "druk/gc/types/gc_array.h"
+#include "druk/gc/types/gc_string.h"
+#include "druk/gc/types/gc_struct.h"
+
+namespace druk::gc
+{
+
+GcObject* GcHeap::forwarded(GcObject* obj) const
+{
+    auto it = forwarding_.find(obj);
+    return it == forwarding_.end() ? obj : it->second;
+}
+
+std::string_view GcHeap::forwarded(std::string_view chars) const
+{
+    if (forwarding_.empty() || !chars.data())
+        return chars;
+    // A string's bytes directly follow its header, so a view of a whole heap string starts
+    // sizeof(GcString) bytes past the object.
+    auto* header = reinterpret_cast<GcObject*>(reinterpret_cast<uintptr_t>(chars.data()) -
+                                               sizeof(GcString));
+    auto  it     = forwarding_.find(header);
+    if (it == forwarding_.end() || it->second->kind != GcType::String)
+        return chars;
+    return {static_cast<GcString*>(it->second)->chars(), chars.size()};
+}
+
+void GcHeap::updateReferences()
+{
+    space_.forEachObject(
+        [](GcObject* obj, size_t)
+        {
+            switch (obj->kind)
+            {
+                case GcType::Array:
+                    for (auto& elem : static_cast<GcArray*>(obj)->elements) elem.updateGcRefs();
+                    break;
+                case GcType::Struct:
+                    for (auto& field : static_cast<GcStruct*>(obj)->fields) field.updateGcRefs();
+                    break;
+                case GcType::String:
+                case GcType::Function:
+                    break;
+            }
+        });
+    for (GcObject* function : markedFunctions_)
+        for (auto& constant : static_cast<codegen::ObjFunction*>(function)->chunk.constants())
+            constant.updateGcRefs();
+    roots_.updateAll();
+    profile_.relocate(forwarding_);
+}
+
+}  // namespace druk::gc
@@ -1,8 +1,40 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
 #include "druk/gc/gc_heap.h"
 
 namespace druk::gc
 {
 
+GcHeap::GcHeap()
+{
+    if (const char* growth = std::getenv("DRUK_GC_GROWTH"))
+        setGrowthPercent(std::strtoull(growth, nullptr, 10));
+    if (const char* threads = std::getenv("DRUK_GC_THREADS"))
+        setMarkThreads(std::strtoull(threads, nullptr, 10));
+    if (const char* pause = std::getenv("DRUK_GC_PAUSE_US"))
+        setPauseBudget(std::strtoull(pause, nullptr, 10));
+    if (const char* sweep = std::getenv("DRUK_GC_BACKGROUND_SWEEP"))
+        setBackgroundSweep(std::strtoull(sweep, nullptr, 10) != 0);
+    if (const char* level = std::getenv("DRUK_GC_STATS"))
+        setStatsLevel(static_cast<GcStatsLevel>(
+            std::min<unsigned long long>(std::strtoull(level, nullptr, 10), 2)));
+    if (const char* compact = std::getenv("DRUK_GC_COMPACT"))
+        setCompactThreshold(std::strtoull(compact, nullptr, 10));
+    if (const char* profile = std::getenv("DRUK_HEAP_PROFILE"))
+        setHeapProfile(std::strtoull(profile, nullptr, 10));
+}
+
+GcHeap::~GcHeap()
+{
+    if (statsLevel_ != GcStatsLevel::Off)
+        stats().print(std::cerr);
+    if (profileInterval_)
+        printHeapProfile(std::cerr, "at exit");
+}
+
 GcHeap& GcHeap::get()
 {
     static GcHeap instance;
@@ -14,15 +46,227 @@ GcRootSet& GcHeap::roots()
     return roots_;
 }
 
+GcPauseHistogram& GcHeap::pauses()
+{
+    return pauses_;
+}
+
+void* GcHeap::allocateSlow(size_t sizeClass, size_t bytes)
+{
+    GcMutator& self = *running_;
+    bool       due;
+    {
+        std::unique_lock<std::mutex> lock(heapMutex_);
+        while (stopping_.load(std::memory_order_relaxed))
+            park(lock, MutatorState::Parked);
+        settle(self);
+        due = collectionDue();
+    }
+    if (due)
+        collectForAllocation();
+
+    std::unique_lock<std::mutex> lock(heapMutex_);
+    while (stopping_.load(std::memory_order_relaxed))
+        park(lock, MutatorState::Parked);
+    void* mem = sizeClass == kSizeClasses.size() ? space_.allocateLarge(bytes)
+                                                 : takeSlot(self, sizeClass, bytes);
+    nurseryBytes_ += bytes;
+
+    // The next budget ends where either trigger would fire, so collections start at the same
+    // allocation they would with one thread and no budget.
+    size_t nurseryRoom = nurseryLimit_ - std::min(nurseryLimit_, nurseryBytes_);
+    size_t oldRoom     = nextCollection_ - std::min(nextCollection_, liveBytes_);
+    self.buffer.budget = std::min({kMutatorBudgetBytes, nurseryRoom, oldRoom});
+    nurseryBytes_ += self.buffer.budget;
+    return mem;
+}
+
+void* GcHeap::takeSlot(GcMutator& self, size_t sizeClass, size_t bytes)
+{
+    GcBumpRun& run  = self.buffer.runs[sizeClass];
+    GcPage*&   page = self.pages[sizeClass];
+    for (;;)
+    {
+        if (page)
+        {
+            if (void* mem = page->allocateFree())
+            {
+                space_.addLive(1);
+                return mem;
+            }
+            if (static_cast<size_t>(run.limit - run.cursor) >= bytes)
+            {
+                void* mem = run.cursor;
+                run.cursor += bytes;
+                return mem;
+            }
+            space_.addLive(page->commitRun(run.cursor));
+            space_.release(page);
+        }
+        // A claimed page has a free slot: on its free list, or else in its run.
+        page       = space_.claim(sizeClass);
+        run.cursor = page->base + page->bump * page->slotSize;
+        run.limit  = page->base + page->slotCount * page->slotSize;
+    }
+}
+
+void GcHeap::notifyGrowthSlow(const GcObject* owner, size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(heapMutex_);
+    if (running_)
+    {
+        while (stopping_.load(std::memory_order_relaxed))
+            park(lock, MutatorState::Parked);
+        settle(*running_);
+    }
+    if (owner->young)
+        nurseryBytes_ += bytes;  // counted as allocated when the nursery is collected
+    else
+    {
+        liveBytes_ += bytes;
+        counters_.bytesAllocated += bytes;
+    }
+}
+
+bool GcHeap::collectionDue() const
+{
+    return nurseryBytes_ >= nurseryLimit_ || liveBytes_ >= nextCollection_;
+}
+
+GcStats GcHeap::stats()
+{
+    WorldStop stop(*this);
+    space_.finishSweep();
+    GcStats stats        = counters_;
+    stats.bytesAllocated = counters_.bytesAllocated + nurseryBytes_;
+    stats.pauses         = pauses_.count();
+    stats.totalPauseUs   = static_cast<uint64_t>(pauses_.total().count() / 1000);
+    stats.maxPauseUs     = static_cast<uint64_t>(pauses_.max().count() / 1000);
+    stats.committedBytes = space_.committedBytes();
+    space_.forEachObject(
+        [&](const GcObject* obj, size_t slotSize)
+        {
+            auto   type  = static_cast<size_t>(obj->kind);
+            size_t bytes = slotSize + payloadBytes(obj);
+            ++stats.liveObjects;
+            stats.liveBytes += bytes;
+            ++stats.liveObjectsByType[type];
+            stats.liveBytesByType[type] += bytes;
+        });
+    return stats;
+}
+
+bool GcHeap::marking() const
+{
+    return marking_;
+}
+
 size_t GcHeap::objectCount() const
 {
-    return count_;
+    std::lock_guard<std::mutex> lock(heapMutex_);
+    size_t                      count = space_.liveCount();
+    for (const GcMutator* mutator : mutators_)
+        count += mutator->objects.load(std::memory_order_relaxed);
+    return count;
+}
+
+size_t GcHeap::heapBytes() const
+{
+    // Includes what running mutators reserved and have not spent yet.
+    std::lock_guard<std::mutex> lock(heapMutex_);
+    return liveBytes_ + nurseryBytes_;
+}
+
+void GcHeap::setGrowthPercent(size_t percent)
+{
+    if (percent > 0)
+        growthPercent_ = percent;
+}
+
+void GcHeap::setMarkThreads(size_t threads)
+{
+#ifdef EMSCRIPTEN
+    threads = 1;  // the wasm build has no pthreads
+#endif
+    if (threads == 0)
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    markThreads_ = threads;
+}
+
+void GcHeap::setPauseBudget(size_t micros)
+{
+    pauseBudget_ = std::chrono::microseconds(static_cast<std::chrono::microseconds::rep>(micros));
+}
+
+void GcHeap::setBackgroundSweep(bool enabled)
+{
+    asyncSweep_ = enabled;
+}
+
+void GcHeap::setStatsLevel(GcStatsLevel level)
+{
+    statsLevel_ = level;
+}
+
+void GcHeap::setCompactThreshold(size_t percent)
+{
+    compactPercent_ = std::min<size_t>(percent, 100);
+}
+
+size_t GcHeap::fragmentation() const
+{
+    return space_.fragmentation();
+}
+
+void GcHeap::setHeapProfile(size_t interval)
+{
+    profileInterval_ = interval;
+}
+
+bool GcHeap::profiling() const
+{
+    return profileInterval_ != 0;
+}
+
+GcHeapProfile& GcHeap::profile()
+{
+    return profile_;
+}
+
+void GcHeap::printHeapProfile(std::ostream& out, const char* when)
+{
+    WorldStop stop(*this);
+    space_.finishSweep();
+    profile_.print(out, space_, when);
+}
+
+void GcHeap::remember(GcObject* obj)
+{
+    obj->remembered = true;
+    if (GcMutator* self = running_)
+    {
+        self->remembered.push_back(obj);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(heapMutex_);
+    remembered_.push_back(obj);
+}
+
+void GcHeap::shade(GcObject* obj)
+{
+    if (GcMutator* self = running_)
+    {
+        markInto(obj, self->gray);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(heapMutex_);
+    markInto(obj, markStack_);
 }
 
-void GcHeap::maybeCollect()
+void GcHeap::forgetRemembered()
 {
-    if (count_ >= threshold_)
-        collect();
+    for (GcObject* obj : remembered_) obj->remembered = false;
+    remembered_.clear();
 }
 
 }  // namespace druk::gc
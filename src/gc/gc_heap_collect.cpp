@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <limits>
+#include <string>
 
 #include "druk/gc/gc_heap.h"
 
@@ -6,52 +10,226 @@
 namespace druk::gc
 {
 
+namespace
+{
+
+// Times the outermost pause only, so a minor collection that escalates counts once.
+class PauseScope
+{
+   public:
+    PauseScope(GcPauseHistogram& pauses, bool& inPause)
+        : pauses_(pauses), inPause_(inPause), outer_(!inPause), start_(Clock::now())
+    {
+        inPause_ = true;
+    }
+
+    ~PauseScope()
+    {
+        if (!outer_)
+            return;
+        inPause_ = false;
+        pauses_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_));
+    }
+
+    PauseScope(const PauseScope&)            = delete;
+    PauseScope& operator=(const PauseScope&) = delete;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    GcPauseHistogram& pauses_;
+    bool&             inPause_;
+    bool              outer_;
+    Clock::time_point start_;
+};
+
+}  // namespace
+
 void GcHeap::markObject(GcObject* obj)
 {
-    if (!obj || obj->marked)
+    markInto(obj, markStack_);
+}
+
+void GcHeap::markInto(GcObject* obj, std::vector<GcObject*>& stack)
+{
+    if (!obj || obj->immortal)
+        return;
+    if (obj->kind == GcType::Function)
+    {
+        std::lock_guard<std::mutex> lock(externalMutex_);
+        if (externalMarks_.insert(obj).second)
+            stack.push_back(obj);
         return;
-    obj->marked = true;
-    obj->trace();
+    }
+    // A minor collection treats every old object as live and never traces through it.
+    if (minor_ && !obj->young)
+        return;
+    if (pinning_)
+        GcPage::of(obj)->pinned = true;
+    if (!GcPage::of(obj)->mark(obj))
+        return;
+    // Whatever a collection marks survives it, so it is old from here on.
+    obj->young = false;
+    stack.push_back(obj);
 }
 
 void GcHeap::markPhase()
 {
-    roots_.traceAll();
+    roots_.traceAll(compacting_ ? &pinning_ : nullptr);
+    if (minor_)
+        for (GcObject* obj : remembered_) traceObject(obj, markStack_);
+    drainMarkStack();
+    // Functions stay put, but the constants of the live ones may reference moved objects.
+    if (compacting_)
+        markedFunctions_.assign(externalMarks_.begin(), externalMarks_.end());
+    externalMarks_.clear();
+}
+
+void GcHeap::collectForAllocation()
+{
+    WorldStop stop(*this);
+    // Another thread may have collected while this one waited.
+    if (!collectionDue())
+        return;
+    if (marking_)
+        markIncrement();
+    else if (nurseryBytes_ >= nurseryLimit_)
+        collectMinor();
+    else if (pauseBudget_.count() > 0)
+        markIncrement();
+    else
+        collect();
 }
 
-void GcHeap::sweepPhase()
+void GcHeap::collectMinor()
 {
-    GcObject** cursor = &head_;
-    size_t     alive  = 0;
-    while (*cursor)
+    WorldStop  stop(*this);
+    PauseScope pause(pauses_, inPause_);
+    // Sweeping young objects mid-cycle would drop marks the cycle already made.
+    if (marking_)
     {
-        if ((*cursor)->marked)
-        {
-            (*cursor)->marked = false;
-            cursor            = &(*cursor)->next;
-            ++alive;
-        }
-        else
-        {
-            GcObject* unreachable = *cursor;
-            *cursor               = unreachable->next;
-            delete unreachable;
-        }
+        collect();
+        return;
     }
-    count_ = alive;
+
+    size_t before = space_.liveCount();
+    minor_        = true;
+    markedBytes_  = 0;
+    markPhase();
+    minor_ = false;
+    forgetRemembered();
+    space_.sweepMinor();
+    liveBytes_ += markedBytes_;
+    ++counters_.minorCollections;
+    counters_.bytesAllocated += nurseryBytes_;
+    counters_.bytesFreed += nurseryBytes_ - std::min(nurseryBytes_, markedBytes_);
+    counters_.objectsFreed += before - space_.liveCount();
+    nurseryBytes_ = 0;
+
+    if (liveBytes_ < nextCollection_)
+        return;
+    if (pauseBudget_.count() > 0)
+        markIncrement();
+    else
+        collect();
+}
+
+void GcHeap::markIncrement()
+{
+    WorldStop  stop(*this);
+    PauseScope pause(pauses_, inPause_);
+    ++counters_.markIncrements;
+    if (!marking_)
+    {
+        // Objects allocated during the cycle start unmarked: whatever still references them at
+        // the end is either a root, rescanned then, or was stored through the write barrier.
+        space_.finishSweep();
+        size_t headroom = std::max(kNurseryBytes, liveBytes_ / 100 * growthPercent_);
+        marking_        = true;
+        markedBytes_    = 0;
+        markDeadline_   = nurseryBytes_ + headroom;
+        nextCollection_ = std::numeric_limits<size_t>::max();
+        roots_.traceAll();
+    }
+
+    drainIncrement(std::chrono::steady_clock::now() + pauseBudget_);
+
+    // Marking ran dry, or allocation outran it: finish the cycle in this pause.
+    if ((markStack_.empty() && !partialArray_) || nurseryBytes_ >= markDeadline_)
+        collect();
+    else
+        nurseryLimit_ = nurseryBytes_ + kMarkStepBytes;
 }
 
 void GcHeap::collect()
 {
-    size_t before = count_;
+    WorldStop  stop(*this);
+    PauseScope pause(pauses_, inPause_);
+    size_t     before      = space_.liveCount();
+    size_t     beforeBytes = liveBytes_ + nurseryBytes_;
+    if (!marking_)
+    {
+        space_.finishSweep();
+        markedBytes_ = 0;
+    }
+    // Finishing an incremental cycle is the same walk: its marks stand and the roots are
+    // rescanned for references the barrier never saw.
+    if (partialArray_)
+        markStack_.push_back(partialArray_);
+    partialArray_ = nullptr;
+    marking_      = false;
     markPhase();
-    sweepPhase();
-    size_t freed = before - count_;
+    // Remembered objects may die below; every survivor is old afterwards anyway.
+    forgetRemembered();
+    space_.beginSweep(asyncSweep_ && !compacting_);
+    size_t freed = before - space_.liveCount();
+    ++counters_.fullCollections;
+    counters_.bytesAllocated += nurseryBytes_;
+    counters_.bytesFreed += beforeBytes - std::min(beforeBytes, markedBytes_);
+    counters_.objectsFreed += freed;
+
+    liveBytes_      = markedBytes_;
+    nurseryBytes_   = 0;
+    nurseryLimit_   = kNurseryBytes;
+    nextCollection_ = std::max(kMinHeapBytes, liveBytes_ + liveBytes_ / 100 * growthPercent_);
+    compactDue_     = compactPercent_ && !compacting_ && fragmentation() > compactPercent_;
+    updateSafepointRequest();
 
-    std::cout << "[GC] Collected " << freed << " objects. " << count_ << " remaining. "
-              << "New threshold: " << threshold_ << std::endl;
+    if (statsLevel_ == GcStatsLevel::Verbose)
+        std::cerr << "[GC] full #" << counters_.fullCollections << ": freed " << freed
+                  << " objects, " << space_.liveCount() << " remaining, live " << liveBytes_
+                  << " bytes, " << fragmentation() << "% fragmented, next at "
+                  << nextCollection_ << " bytes\n";
+    if (profileInterval_ && counters_.fullCollections % profileInterval_ == 0)
+    {
+        std::string when = "after full GC #" + std::to_string(counters_.fullCollections);
+        printHeapProfile(std::cerr, when.c_str());
+    }
+}
+
+void GcHeap::compact()
+{
+    WorldStop stop(*this);
+    // A thread stopped inside the heap may hold references in C++ locals; its next safepoint
+    // tries again.
+    if (!othersAtSafepoints())
+        return;
+    PauseScope pause(pauses_, inPause_);
+    compactDue_ = false;
+    updateSafepointRequest();
+    compacting_ = true;
+    collect();
+    compacting_ = false;
 
-    threshold_ = (count_ < kMinThreshold) ? kInitialThreshold : count_ * kGrowthFactor;
+    // Survivors are all old and the sweep is done, so every page holds exactly its live objects.
+    space_.finishSweep();
+    space_.compact(forwarding_);
+    if (!forwarding_.empty())
+        updateReferences();
+    ++counters_.compactions;
+    counters_.objectsMoved += forwarding_.size();
+    forwarding_.clear();
+    markedFunctions_.clear();
 }
 
 }  // namespace druk::gc
@@ -0,0 +1,47 @@
+#include "druk/gc/gc_layout.h"
+
+#include "druk/gc/types/gc_array.h"
+#include "druk/gc/types/gc_struct.h"
+
+namespace druk::gc
+{
+
+namespace
+{
+
+size_t offsetIn(const void* object, const void* field)
+{
+    return static_cast<size_t>(static_cast<const std::byte*>(field) -
+                               static_cast<const std::byte*>(object));
+}
+
+}  // namespace
+
+const GcObjectLayout& GcObjectLayout::get()
+{
+    static const GcObjectLayout layout = []
+    {
+        GcObjectLayout result{};
+
+        GcArray array;
+        result.young         = offsetIn(&array, &array.young);
+        result.remembered    = offsetIn(&array, &array.remembered);
+        result.kind          = offsetIn(&array, &array.kind);
+        result.immortal      = offsetIn(&array, &array.immortal);
+        result.arrayData     = offsetIn(&array, &array.elements.data_);
+        result.arraySize     = offsetIn(&array, &array.elements.size_);
+        result.arrayCapacity = offsetIn(&array, &array.elements.capacity_);
+        result.arrayInline   = offsetIn(&array, array.elements.inline_);
+
+        GcStruct struc;
+        result.structShape    = offsetIn(&struc, &struc.shape);
+        result.structData     = offsetIn(&struc, &struc.fields.data_);
+        result.structSize     = offsetIn(&struc, &struc.fields.size_);
+        result.structCapacity = offsetIn(&struc, &struc.fields.capacity_);
+        result.structInline   = offsetIn(&struc, struc.fields.inline_);
+        return result;
+    }();
+    return layout;
+}
+
+}  // namespace druk::gc
@@ -0,0 +1,132 @@
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "druk/gc/gc_heap.h"
+
+namespace druk::gc
+{
+
+namespace
+{
+
+// A worker hands half of its private stack to thieves once it holds more than this many
+// objects and its shared queue has run dry.
+constexpr size_t kPublishThreshold = 64;
+
+// Each worker traces from a private stack and only takes its mutex to publish surplus work or
+// when another worker steals from its shared queue.
+struct MarkWorker
+{
+    std::vector<GcObject*> local;
+    std::mutex             mutex;
+    std::vector<GcObject*> shared;  // guarded by mutex
+    std::atomic<size_t>    sharedSize{0};
+    size_t                 markedBytes = 0;
+};
+
+using MarkWorkers = std::vector<std::unique_ptr<MarkWorker>>;
+
+void publish(MarkWorker& worker)
+{
+    auto                        half = static_cast<std::ptrdiff_t>(worker.local.size() / 2);
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    // The bottom of the stack sits closest to the roots, so it tends to hold the larger subgraphs.
+    worker.shared.insert(worker.shared.end(), worker.local.begin(), worker.local.begin() + half);
+    worker.local.erase(worker.local.begin(), worker.local.begin() + half);
+    worker.sharedSize.store(worker.shared.size(), std::memory_order_release);
+}
+
+// Moves half of the first non-empty shared queue, starting with the thief's own, onto its stack.
+bool steal(MarkWorkers& workers, size_t self)
+{
+    MarkWorker& thief = *workers[self];
+    for (size_t i = 0; i < workers.size(); ++i)
+    {
+        MarkWorker& victim = *workers[(self + i) % workers.size()];
+        if (victim.sharedSize.load(std::memory_order_acquire) == 0)
+            continue;
+
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        size_t                      take = (victim.shared.size() + 1) / 2;
+        if (take == 0)
+            continue;
+        auto from = victim.shared.end() - static_cast<std::ptrdiff_t>(take);
+        thief.local.insert(thief.local.end(), from, victim.shared.end());
+        victim.shared.erase(from, victim.shared.end());
+        victim.sharedSize.store(victim.shared.size(), std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
+bool hasSharedWork(const MarkWorkers& workers)
+{
+    for (const auto& worker : workers)
+        if (worker->sharedSize.load(std::memory_order_acquire) != 0)
+            return true;
+    return false;
+}
+
+}  // namespace
+
+void GcHeap::drainParallel()
+{
+    size_t      count = markThreads_;
+    MarkWorkers workers;
+    for (size_t i = 0; i < count; ++i) workers.push_back(std::make_unique<MarkWorker>());
+
+    // Roots are dealt round-robin so every worker starts with something to trace.
+    for (size_t i = 0; i < markStack_.size(); ++i)
+        workers[i % count]->shared.push_back(markStack_[i]);
+    markStack_.clear();
+    for (auto& worker : workers) worker->sharedSize.store(worker->shared.size());
+
+    // Marking is done once every worker is idle: only active workers can publish, and an idle
+    // worker counts itself active again before it tries to steal.
+    std::atomic<size_t> active{count};
+    auto                work = [&](size_t self)
+    {
+        MarkWorker& worker = *workers[self];
+        for (;;)
+        {
+            while (!worker.local.empty())
+            {
+                GcObject* obj = worker.local.back();
+                worker.local.pop_back();
+                worker.markedBytes += traceObject(obj, worker.local);
+                if (worker.local.size() > kPublishThreshold &&
+                    worker.sharedSize.load(std::memory_order_relaxed) == 0)
+                    publish(worker);
+            }
+            if (steal(workers, self))
+                continue;
+
+            active.fetch_sub(1, std::memory_order_acq_rel);
+            for (;;)
+            {
+                if (active.load(std::memory_order_acquire) == 0)
+                    return;
+                if (hasSharedWork(workers))
+                {
+                    active.fetch_add(1, std::memory_order_acq_rel);
+                    if (steal(workers, self))
+                        break;
+                    active.fetch_sub(1, std::memory_order_acq_rel);
+                }
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    // The collecting thread is worker 0.
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < count; ++i) threads.emplace_back(work, i);
+    work(0);
+    for (auto& thread : threads) thread.join();
+    for (auto& worker : workers) markedBytes_ += worker->markedBytes;
+}
+
+}  // namespace druk::gc
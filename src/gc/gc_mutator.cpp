@@ -0,0 +1,233 @@
+#include "druk/gc/gc_mutator.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "druk/gc/gc_heap.h"
+
+namespace druk::gc
+{
+
+namespace
+{
+
+// The untimed condition_variable::wait is a GLIBCXX_3.4.30 symbol that older libstdc++ runtimes
+// lack; the timed one is inline.
+template <typename Ready>
+void waitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, Ready ready)
+{
+    while (!cv.wait_for(lock, std::chrono::milliseconds(100), ready))
+    {
+    }
+}
+
+}  // namespace
+
+// Owns the calling thread's mutator; the heap forgets it when the thread exits.
+struct GcHeap::MutatorSlot
+{
+    GcMutator mutator;
+    bool      attached = false;
+
+    ~MutatorSlot()
+    {
+        if (attached)
+            GcHeap::get().detach(mutator);
+    }
+};
+
+GcMutatorScope::GcMutatorScope()
+{
+    GcHeap::get().enter();
+}
+
+GcMutatorScope::~GcMutatorScope()
+{
+    GcHeap::get().leave();
+}
+
+GcNativeScope::GcNativeScope() : running_(GcHeap::get().suspend()) {}
+
+GcNativeScope::~GcNativeScope()
+{
+    if (running_)
+        GcHeap::get().resume();
+}
+
+GcMutator& GcHeap::mutator()
+{
+    thread_local MutatorSlot slot;
+    if (!slot.attached)
+    {
+        std::lock_guard<std::mutex> lock(heapMutex_);
+        mutators_.push_back(&slot.mutator);
+        slot.attached = true;
+    }
+    return slot.mutator;
+}
+
+GcAllocationBuffer& GcHeap::allocationBuffer()
+{
+    return mutator().buffer;
+}
+
+void GcHeap::enter()
+{
+    GcMutator& self = mutator();
+    if (self.depth++ > 0)
+        return;
+    resume();
+}
+
+void GcHeap::leave()
+{
+    GcMutator& self = mutator();
+    if (--self.depth > 0)
+        return;
+    suspend();
+}
+
+bool GcHeap::suspend()
+{
+    GcMutator* self = running_;
+    if (!self)
+        return false;
+    std::lock_guard<std::mutex> lock(heapMutex_);
+    settle(*self);  // the thread keeps its pages, but its counts are exact while it is away
+    running_ = nullptr;
+    self->state.store(MutatorState::Native, std::memory_order_relaxed);
+    worldCv_.notify_all();
+    return true;
+}
+
+void GcHeap::resume()
+{
+    GcMutator& self = mutator();
+    {
+        std::unique_lock<std::mutex> lock(heapMutex_);
+        waitUntil(worldCv_, lock, [&] { return !stopping_.load(std::memory_order_relaxed); });
+        self.state.store(MutatorState::Running, std::memory_order_relaxed);
+    }
+    running_ = &self;
+}
+
+void GcHeap::park(std::unique_lock<std::mutex>& lock, MutatorState state)
+{
+    GcMutator* self = running_;
+    if (self)
+    {
+        self->state.store(state, std::memory_order_relaxed);
+        worldCv_.notify_all();
+    }
+    waitUntil(worldCv_, lock, [&] { return !stopping_.load(std::memory_order_relaxed); });
+    if (self)
+        self->state.store(MutatorState::Running, std::memory_order_relaxed);
+}
+
+void GcHeap::settle(GcMutator& mutator)
+{
+    // The budget was reserved in the nursery; what old objects spent of it moves over to them.
+    nurseryBytes_ -= mutator.buffer.budget + mutator.oldGrowth;
+    liveBytes_ += mutator.oldGrowth;
+    counters_.bytesAllocated += mutator.oldGrowth;
+    mutator.buffer.budget = 0;
+    mutator.oldGrowth     = 0;
+    space_.addLive(mutator.objects.exchange(0, std::memory_order_relaxed));
+    for (size_t cls = 0; cls < kSizeClasses.size(); ++cls)
+        if (GcPage* page = mutator.pages[cls])
+            space_.addLive(page->commitRun(mutator.buffer.runs[cls].cursor));
+    remembered_.insert(remembered_.end(), mutator.remembered.begin(), mutator.remembered.end());
+    mutator.remembered.clear();
+    markStack_.insert(markStack_.end(), mutator.gray.begin(), mutator.gray.end());
+    mutator.gray.clear();
+}
+
+void GcHeap::retire(GcMutator& mutator)
+{
+    for (GcPage*& page : mutator.pages)
+    {
+        if (page)
+            space_.release(page);
+        page = nullptr;
+    }
+    mutator.buffer.runs.fill({});
+}
+
+void GcHeap::detach(GcMutator& mutator)
+{
+    std::lock_guard<std::mutex> lock(heapMutex_);
+    settle(mutator);
+    retire(mutator);
+    mutators_.erase(std::find(mutators_.begin(), mutators_.end(), &mutator));
+    worldCv_.notify_all();
+}
+
+bool GcHeap::othersAtSafepoints() const
+{
+    return std::none_of(mutators_.begin(), mutators_.end(),
+                        [](const GcMutator* mutator) {
+                            return mutator != running_ &&
+                                   mutator->state.load(std::memory_order_relaxed) ==
+                                       MutatorState::Parked;
+                        });
+}
+
+void GcHeap::safepointSlow()
+{
+    {
+        std::unique_lock<std::mutex> lock(heapMutex_);
+        while (stopping_.load(std::memory_order_relaxed))
+            park(lock, MutatorState::Safepoint);
+    }
+    if (compactDue_.load(std::memory_order_relaxed))
+        compact();
+}
+
+void GcHeap::updateSafepointRequest()
+{
+    safepointRequested_.store(stopping_.load(std::memory_order_relaxed) ||
+                                  compactDue_.load(std::memory_order_relaxed),
+                              std::memory_order_release);
+}
+
+GcHeap::WorldStop::WorldStop(GcHeap& heap) : heap_(heap)
+{
+    if (heap.collector_.load(std::memory_order_relaxed) == std::this_thread::get_id())
+        return;
+    lock_ = std::unique_lock<std::mutex>(heap.heapMutex_);
+    // Another thread is collecting: wait it out like any mutator, then take a turn.
+    while (heap.stopping_.load(std::memory_order_relaxed))
+        heap.park(lock_, MutatorState::Parked);
+    heap.stopping_.store(true, std::memory_order_release);
+    heap.updateSafepointRequest();
+    heap.collector_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+    const GcMutator* self = running_;
+    waitUntil(heap.worldCv_, lock_,
+              [&]
+              {
+                  return std::none_of(heap.mutators_.begin(), heap.mutators_.end(),
+                                      [&](const GcMutator* mutator) {
+                                          return mutator != self &&
+                                                 mutator->state.load(std::memory_order_relaxed) ==
+                                                     MutatorState::Running;
+                                      });
+              });
+    for (GcMutator* mutator : heap.mutators_)
+    {
+        heap.settle(*mutator);
+        heap.retire(*mutator);
+    }
+}
+
+GcHeap::WorldStop::~WorldStop()
+{
+    if (!lock_.owns_lock())
+        return;
+    heap_.collector_.store(std::thread::id(), std::memory_order_relaxed);
+    heap_.stopping_.store(false, std::memory_order_release);
+    heap_.updateSafepointRequest();
+    heap_.worldCv_.notify_all();
+}
+
+}  // namespace druk::gc
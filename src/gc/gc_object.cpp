@@ -0,0 +1,71 @@
+#include "druk/gc/gc_object.h"
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "druk/codegen/core/value.h"
+#include "druk/gc/types/gc_array.h"
+#include "druk/gc/types/gc_string.h"
+#include "druk/gc/types/gc_struct.h"
+
+namespace druk::gc
+{
+
+const char* gcTypeName(GcType type)
+{
+    switch (type)
+    {
+        case GcType::Array:
+            return "array";
+        case GcType::String:
+            return "string";
+        case GcType::Struct:
+            return "struct";
+        case GcType::Function:
+            return "function";
+    }
+    return "unknown";
+}
+
+void destroyObject(GcObject* obj)
+{
+    switch (obj->kind)
+    {
+        case GcType::Array:
+            static_cast<GcArray*>(obj)->~GcArray();
+            break;
+        case GcType::String:
+            static_cast<GcString*>(obj)->~GcString();
+            break;
+        case GcType::Struct:
+            static_cast<GcStruct*>(obj)->~GcStruct();
+            break;
+        case GcType::Function:
+            break;  // owned by the compiler, never in a heap page
+    }
+}
+
+void relocateObject(GcObject* from, void* to)
+{
+    switch (from->kind)
+    {
+        case GcType::Array:
+            new (to) GcArray(std::move(*static_cast<GcArray*>(from)));
+            break;
+        case GcType::String:
+        {
+            auto* str = static_cast<GcString*>(from);
+            std::memcpy(to, str, GcString::allocationSize(str->length()));
+            return;  // nothing to destroy: the bytes are all inline
+        }
+        case GcType::Struct:
+            new (to) GcStruct(std::move(*static_cast<GcStruct*>(from)));
+            break;
+        case GcType::Function:
+            return;  // never in a heap page
+    }
+    destroyObject(from);
+}
+
+}  // namespace druk::gc
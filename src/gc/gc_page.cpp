@@ -0,0 +1,491 @@
+#include "druk/gc/gc_page.h"
+
+#include <bit>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "druk/gc/gc_object.h"
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace druk::gc
+{
+
+namespace
+{
+
+constexpr size_t kHeaderSize =
+    (sizeof(GcPage) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+size_t largePageBytes(size_t objectBytes)
+{
+    // aligned_alloc wants a multiple of the alignment; the object still starts in the first
+    // kPageSize bytes, so GcPage::of finds the header.
+    return (kHeaderSize + objectBytes + kPageSize - 1) & ~(kPageSize - 1);
+}
+
+// Tallies, over the size classes, how many of the occupied pages a compaction could release:
+// those beyond what each class's survivors fill when packed.
+class Occupancy
+{
+   public:
+    void addPage(size_t survivors)
+    {
+        if (survivors == 0)
+            return;
+        objects_ += survivors;
+        ++classPages_;
+    }
+
+    void endClass(size_t slotsPerPage)
+    {
+        size_t needed = (objects_ + slotsPerPage - 1) / slotsPerPage;
+        pages_ += classPages_;
+        releasable_ += classPages_ - needed;
+        objects_    = 0;
+        classPages_ = 0;
+    }
+
+    size_t percent() const { return pages_ ? releasable_ * 100 / pages_ : 0; }
+
+   private:
+    size_t objects_    = 0;
+    size_t classPages_ = 0;
+    size_t pages_      = 0;
+    size_t releasable_ = 0;
+};
+
+void* allocPageMemory(size_t bytes = kPageSize)
+{
+#ifdef _WIN32
+    void* mem = _aligned_malloc(bytes, kPageSize);
+#else
+    void* mem = std::aligned_alloc(kPageSize, bytes);
+#endif
+    if (!mem)
+        throw std::bad_alloc();
+    return mem;
+}
+
+void freePageMemory(GcPage* page)
+{
+    page->~GcPage();
+#ifdef _WIN32
+    _aligned_free(page);
+#else
+    std::free(page);
+#endif
+}
+
+}  // namespace
+
+GcPage* GcPage::of(const void* ptr)
+{
+    return reinterpret_cast<GcPage*>(reinterpret_cast<uintptr_t>(ptr) &
+                                     ~static_cast<uintptr_t>(kPageSize - 1));
+}
+
+void* GcPage::allocate()
+{
+    if (void* mem = allocateFree())
+        return mem;
+    if (bump == slotCount)
+        return nullptr;
+    void* mem = base + bump * slotSize;
+    commitRun(base + (bump + 1) * slotSize);
+    return mem;
+}
+
+void* GcPage::allocateFree()
+{
+    void* mem = freeList;
+    if (!mem)
+        return nullptr;
+    freeList = *static_cast<void**>(mem);
+
+    size_t index = static_cast<size_t>(static_cast<std::byte*>(mem) - base) / slotSize;
+    liveBits[index / 64] |= uint64_t{1} << (index % 64);
+    ++live;
+    return mem;
+}
+
+size_t GcPage::commitRun(const std::byte* cursor)
+{
+    size_t end   = static_cast<size_t>(cursor - base) / slotSize;
+    size_t count = end - bump;
+    for (; bump < end; ++bump) liveBits[bump / 64] |= uint64_t{1} << (bump % 64);
+    live += count;
+    return count;
+}
+
+bool GcPage::mark(const GcObject* obj)
+{
+    size_t   index = indexOf(obj);
+    uint64_t bit   = uint64_t{1} << (index % 64);
+    auto&    word  = markBits[index / 64];
+    // A plain load first: revisits are common and should not pay for a locked read-modify-write.
+    if (word.load(std::memory_order_relaxed) & bit)
+        return false;
+    return !(word.fetch_or(bit, std::memory_order_relaxed) & bit);
+}
+
+GcObject* GcPage::slot(size_t index) const
+{
+    return reinterpret_cast<GcObject*>(base + index * slotSize);
+}
+
+size_t GcPage::indexOf(const GcObject* obj) const
+{
+    return static_cast<size_t>(reinterpret_cast<const std::byte*>(obj) - base) / slotSize;
+}
+
+GcPageSpace::~GcPageSpace()
+{
+    stopSweeper();
+    for (auto& pages : pages_)
+    {
+        for (GcPage* page : pages)
+        {
+            for (size_t index = 0; index < page->bump; ++index)
+                if (page->liveBits[index / 64] & (uint64_t{1} << (index % 64)))
+                    destroyObject(page->slot(index));
+            freePageMemory(page);
+        }
+    }
+    for (GcPage* page : largePages_)
+    {
+        if (page->live)
+            destroyObject(page->slot(0));
+        freePageMemory(page);
+    }
+}
+
+GcPage* GcPageSpace::newPage(size_t sizeClass)
+{
+    auto* page      = new (allocPageMemory()) GcPage();
+    page->sizeClass = sizeClass;
+    page->slotSize  = kSizeClasses[sizeClass];
+    page->slotCount = (kPageSize - kHeaderSize) / page->slotSize;
+    page->base      = reinterpret_cast<std::byte*>(page) + kHeaderSize;
+    pages_[sizeClass].push_back(page);
+    return page;
+}
+
+GcPage* GcPageSpace::claim(size_t sizeClass)
+{
+    auto&   pages = pages_[sizeClass];
+    size_t& first = current_[sizeClass];
+    for (size_t i = first;; ++i)
+    {
+        GcPage* page = i < pages.size() ? pages[i] : newPage(sizeClass);
+        if (page->owned)
+            continue;
+        if (sweepPending_)
+            sweepPending(page);
+        if (!page->freeList && page->bump == page->slotCount)
+        {
+            // Full pages ahead of every claimed one are skipped for good.
+            if (i == first)
+                ++first;
+            continue;
+        }
+        if (!page->hasYoung)
+        {
+            page->hasYoung = true;
+            youngPages_.push_back(page);
+        }
+        page->owned = true;
+        return page;
+    }
+}
+
+void* GcPageSpace::allocateLarge(size_t bytes)
+{
+    auto* page      = new (allocPageMemory(largePageBytes(bytes))) GcPage();
+    page->sizeClass = kSizeClasses.size();
+    page->slotSize  = bytes;
+    page->slotCount = 1;
+    page->base      = reinterpret_cast<std::byte*>(page) + kHeaderSize;
+    page->hasYoung  = true;
+    largePages_.push_back(page);
+    youngPages_.push_back(page);
+    ++live_;
+    return page->allocate();
+}
+
+size_t GcPageSpace::sweepPage(GcPage* page, bool minor)
+{
+    size_t freed = 0;
+    for (size_t w = 0; w < GcPage::kWords; ++w)
+    {
+        uint64_t bits = page->liveBits[w];
+        while (bits)
+        {
+            size_t   offset = static_cast<size_t>(std::countr_zero(bits));
+            size_t   index  = w * 64 + offset;
+            uint64_t bit    = uint64_t{1} << offset;
+            bits &= bits - 1;
+
+            if (page->markBits[w].load(std::memory_order_relaxed) & bit)
+                continue;
+            GcObject* obj = page->slot(index);
+            if (minor && !obj->young)
+                continue;
+
+            destroyObject(obj);
+            page->liveBits[w] &= ~bit;
+            *reinterpret_cast<void**>(obj) = page->freeList;
+            page->freeList                 = obj;
+            --page->live;
+            ++freed;
+        }
+        page->markBits[w].store(0, std::memory_order_relaxed);
+    }
+    return freed;
+}
+
+void GcPageSpace::sweepPending(GcPage* page)
+{
+    if (page->sweepState.load(std::memory_order_acquire) == SweepState::Swept)
+        return;
+    auto expected = SweepState::Pending;
+    if (page->sweepState.compare_exchange_strong(expected, SweepState::Sweeping,
+                                                 std::memory_order_acquire))
+    {
+        size_t freed = sweepPage(page, false);
+        live_ -= freed;
+        pendingDead_ -= freed;
+        page->sweepState.store(SweepState::Swept, std::memory_order_release);
+        return;
+    }
+    // The background sweeper holds the page; it is only ever a single page's worth of work.
+    while (page->sweepState.load(std::memory_order_acquire) != SweepState::Swept)
+        std::this_thread::yield();
+}
+
+void GcPageSpace::backgroundSweep(std::vector<GcPage*> pages)
+{
+    size_t freed = 0;
+    for (GcPage* page : pages)
+    {
+        if (stopSweeper_.load(std::memory_order_relaxed))
+            break;
+        auto expected = SweepState::Pending;
+        if (!page->sweepState.compare_exchange_strong(expected, SweepState::Sweeping,
+                                                      std::memory_order_acquire))
+            continue;
+        freed += sweepPage(page, false);
+        page->sweepState.store(SweepState::Swept, std::memory_order_release);
+    }
+    sweeperFreed_.store(freed, std::memory_order_release);
+}
+
+void GcPageSpace::stopSweeper()
+{
+    if (!sweeper_.joinable())
+        return;
+    stopSweeper_.store(true, std::memory_order_relaxed);
+    sweeper_.join();
+    stopSweeper_.store(false, std::memory_order_relaxed);
+    size_t freed = sweeperFreed_.exchange(0, std::memory_order_acquire);
+    live_ -= freed;
+    pendingDead_ -= freed;
+}
+
+void GcPageSpace::sweepMinor()
+{
+    size_t freed = 0;
+    for (GcPage* page : youngPages_)
+    {
+        freed += sweepPage(page, true);
+        page->hasYoung = false;
+    }
+    youngPages_.clear();
+    live_ -= freed;
+    releaseEmptyLargePages();
+    // The background sweeper walks a snapshot of the page lists, so pages stay put until a
+    // pending sweep finishes; allocation still restarts from the first page to reuse slots.
+    if (sweepPending_)
+        current_.fill(0);
+    else
+        releaseEmptyPages();
+}
+
+void GcPageSpace::beginSweep(bool background)
+{
+    for (GcPage* page : largePages_)
+    {
+        live_ -= sweepPage(page, false);
+        page->hasYoung = false;
+    }
+    releaseEmptyLargePages();
+
+    size_t    marked = largePages_.size();
+    Occupancy occupancy;
+    for (size_t cls = 0; cls < pages_.size(); ++cls)
+    {
+        for (GcPage* page : pages_[cls])
+        {
+            size_t survivors = 0;
+            for (size_t w = 0; w < GcPage::kWords; ++w)
+                survivors += static_cast<size_t>(
+                    std::popcount(page->markBits[w].load(std::memory_order_relaxed)));
+            marked += survivors;
+            occupancy.addPage(survivors);
+            page->hasYoung = false;
+            page->sweepState.store(SweepState::Pending, std::memory_order_relaxed);
+        }
+        occupancy.endClass((kPageSize - kHeaderSize) / kSizeClasses[cls]);
+    }
+    youngPages_.clear();
+    current_.fill(0);
+    pendingDead_   = live_ - marked;
+    sweepPending_  = true;
+    fragmentation_ = occupancy.percent();
+
+#ifndef EMSCRIPTEN
+    if (background)
+    {
+        std::vector<GcPage*> snapshot;
+        for (auto& pages : pages_) snapshot.insert(snapshot.end(), pages.begin(), pages.end());
+        sweeper_ = std::thread(&GcPageSpace::backgroundSweep, this, std::move(snapshot));
+    }
+#else
+    (void)background;
+#endif
+}
+
+void GcPageSpace::finishSweep()
+{
+    if (!sweepPending_)
+        return;
+    stopSweeper();
+    for (auto& pages : pages_)
+        for (GcPage* page : pages) sweepPending(page);
+    sweepPending_ = false;
+    releaseEmptyPages();
+}
+
+void GcPageSpace::releaseEmptyPages()
+{
+    for (size_t cls = 0; cls < pages_.size(); ++cls)
+    {
+        auto&  pages = pages_[cls];
+        size_t kept  = 0;
+        for (GcPage* page : pages)
+        {
+            if (page->live == 0)
+                freePageMemory(page);
+            else
+                pages[kept++] = page;
+        }
+        pages.resize(kept);
+        current_[cls] = 0;
+    }
+}
+
+void GcPageSpace::releaseEmptyLargePages()
+{
+    size_t kept = 0;
+    for (GcPage* page : largePages_)
+    {
+        if (page->live == 0)
+            freePageMemory(page);
+        else
+            largePages_[kept++] = page;
+    }
+    largePages_.resize(kept);
+}
+
+void GcPageSpace::compact(GcForwardingTable& forwarding)
+{
+    Occupancy occupancy;
+    for (size_t cls = 0; cls < pages_.size(); ++cls)
+    {
+        auto&                pages   = pages_[cls];
+        size_t               perPage = (kPageSize - kHeaderSize) / kSizeClasses[cls];
+        std::vector<GcPage*> movable;
+        size_t               live = 0;
+        for (GcPage* page : pages)
+        {
+            if (page->pinned)
+                continue;
+            movable.push_back(page);
+            live += page->live;
+        }
+        if ((live + perPage - 1) / perPage < movable.size())
+            slide(movable, forwarding);
+
+        for (GcPage* page : pages)
+        {
+            page->pinned = false;
+            occupancy.addPage(page->live);
+        }
+        occupancy.endClass(perPage);
+    }
+    releaseEmptyPages();
+    fragmentation_ = occupancy.percent();
+}
+
+void GcPageSpace::slide(const std::vector<GcPage*>& pages, GcForwardingTable& forwarding)
+{
+    // Survivors keep their order and are packed slot by slot from the first page on. A survivor
+    // never lands past its own slot, so every destination is free or was vacated earlier.
+    size_t to   = 0;
+    size_t next = 0;
+    for (size_t from = 0; from < pages.size(); ++from)
+    {
+        GcPage* page = pages[from];
+        for (size_t w = 0; w < GcPage::kWords; ++w)
+        {
+            for (uint64_t bits = page->liveBits[w]; bits; bits &= bits - 1)
+            {
+                size_t index = w * 64 + static_cast<size_t>(std::countr_zero(bits));
+                if (next == pages[to]->slotCount)
+                {
+                    ++to;
+                    next = 0;
+                }
+                if (to != from || next != index)
+                {
+                    GcObject* obj  = page->slot(index);
+                    GcObject* dest = pages[to]->slot(next);
+                    relocateObject(obj, dest);
+                    forwarding.emplace(obj, dest);
+                }
+                ++next;
+            }
+        }
+    }
+
+    // The survivors now fill a prefix of the slots; pages past it are empty and get released.
+    for (size_t i = 0; i < pages.size(); ++i)
+    {
+        GcPage* page  = pages[i];
+        size_t  count = i < to ? page->slotCount : i == to ? next : 0;
+        page->liveBits.fill(0);
+        for (size_t index = 0; index < count; ++index)
+            page->liveBits[index / 64] |= uint64_t{1} << (index % 64);
+        page->live     = count;
+        page->bump     = count;
+        page->freeList = nullptr;
+    }
+}
+
+size_t GcPageSpace::committedBytes() const
+{
+    size_t bytes = 0;
+    for (const auto& pages : pages_) bytes += pages.size() * kPageSize;
+    for (const GcPage* page : largePages_) bytes += largePageBytes(page->slotSize);
+    return bytes;
+}
+
+size_t GcPageSpace::liveCount() const
+{
+    return live_ - pendingDead_;
+}
+
+}  // namespace druk::gc
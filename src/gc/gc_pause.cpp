@@ -0,0 +1,42 @@
+#include "druk/gc/gc_pause.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace druk::gc
+{
+
+void GcPauseHistogram::record(std::chrono::nanoseconds pause)
+{
+    auto   micros = static_cast<uint64_t>(pause.count() / 1000);
+    size_t index  = std::min(static_cast<size_t>(std::bit_width(micros)), kBuckets - 1);
+    ++buckets_[index];
+    ++count_;
+    max_ = std::max(max_, pause);
+    total_ += pause;
+}
+
+void GcPauseHistogram::reset()
+{
+    *this = GcPauseHistogram();
+}
+
+void GcPauseHistogram::print(std::ostream& out) const
+{
+    out << "GC pauses: " << count_ << ", total " << total_.count() / 1000 << " us, max "
+        << max_.count() / 1000 << " us\n";
+    for (size_t i = 0; i < kBuckets; ++i)
+    {
+        if (buckets_[i] == 0)
+            continue;
+        size_t upper = size_t{1} << i;
+        if (i + 1 == kBuckets)
+            out << "  >= " << upper / 2 << " us";
+        else
+            out << "  < " << upper << " us";
+        out << ": " << buckets_[i] << "\n";
+    }
+}
+
+}  // namespace druk::gc
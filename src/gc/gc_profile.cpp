@@ -0,0 +1,101 @@
+#include "druk/gc/gc_profile.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+
+namespace druk::gc
+{
+
+namespace
+{
+
+struct SiteCensus
+{
+    size_t                           objects = 0;
+    size_t                           bytes   = 0;
+    std::array<size_t, kGcTypeCount> objectsByType{};
+};
+
+}  // namespace
+
+uint32_t GcHeapProfile::addSite(std::string label)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    labels_.push_back(std::move(label));
+    return static_cast<uint32_t>(labels_.size() - 1);
+}
+
+void GcHeapProfile::relocate(const GcForwardingTable& forwarding)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Dead objects keep their entries until the next print, so a moved object may land on the
+    // address of one: moved entries are written last and win.
+    std::unordered_map<const GcObject*, uint32_t> sites;
+    sites.reserve(sites_.size());
+    for (const auto& [obj, site] : sites_)
+        if (!forwarding.count(const_cast<GcObject*>(obj)))
+            sites.emplace(obj, site);
+    for (const auto& [obj, site] : sites_)
+    {
+        auto it = forwarding.find(const_cast<GcObject*>(obj));
+        if (it != forwarding.end())
+            sites[it->second] = site;
+    }
+    sites_ = std::move(sites);
+}
+
+void GcHeapProfile::print(std::ostream& out, const GcPageSpace& space, const char* when)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<SiteCensus>                       census(labels_.size());
+    std::unordered_map<const GcObject*, uint32_t> live;
+    SiteCensus                                    total;
+    space.forEachObject(
+        [&](const GcObject* obj, size_t slotSize)
+        {
+            auto     it    = sites_.find(obj);
+            uint32_t site  = it == sites_.end() ? 0 : it->second;
+            size_t   bytes = slotSize + payloadBytes(obj);
+            auto     type  = static_cast<size_t>(obj->kind);
+            for (SiteCensus* entry : {&census[site], &total})
+            {
+                ++entry->objects;
+                entry->bytes += bytes;
+                ++entry->objectsByType[type];
+            }
+            if (it != sites_.end())
+                live.emplace(obj, site);
+        });
+    sites_ = std::move(live);
+
+    std::vector<uint32_t> order;
+    for (uint32_t site = 0; site < census.size(); ++site)
+        if (census[site].objects)
+            order.push_back(site);
+    std::sort(order.begin(), order.end(),
+              [&](uint32_t a, uint32_t b) { return census[a].bytes > census[b].bytes; });
+
+    out << "Heap profile " << when << ": " << total.objects << " objects, " << total.bytes
+        << " bytes\n";
+    for (uint32_t site : order)
+    {
+        const SiteCensus& entry = census[site];
+        out << "  " << entry.bytes << " bytes, " << entry.objects << " objects  " << labels_[site]
+            << " (";
+        const char* separator = "";
+        for (size_t type = 0; type < kGcTypeCount; ++type)
+        {
+            if (entry.objectsByType[type] == 0)
+                continue;
+            out << separator << gcTypeName(static_cast<GcType>(type)) << " "
+                << entry.objectsByType[type];
+            separator = ", ";
+        }
+        out << ")\n";
+    }
+}
+
+}  // namespace druk::gc
@@ -1,21 +1,180 @@
 #include "druk/gc/gc_roots.h"
 
+#include <utility>
+
+#include "druk/codegen/core/value.h"
+#include "druk/gc/gc_heap.h"
+
 namespace druk::gc
 {
 
-void GcRootSet::addSource(TraceCallback cb)
+GcRootHandle::~GcRootHandle()
+{
+    reset();
+}
+
+GcRootHandle::GcRootHandle(GcRootHandle&& other) noexcept
+    : set_(std::exchange(other.set_, nullptr)), index_(other.index_)
+{
+}
+
+GcRootHandle& GcRootHandle::operator=(GcRootHandle&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        set_   = std::exchange(other.set_, nullptr);
+        index_ = other.index_;
+    }
+    return *this;
+}
+
+void GcRootHandle::update(const void* data, size_t count)
+{
+    std::lock_guard<std::mutex> lock(set_->mutex_);
+
+    auto& root = set_->roots_[index_];
+    root.data  = data;
+    root.count = count;
+}
+
+void GcRootHandle::reset()
+{
+    if (set_)
+        std::exchange(set_, nullptr)->remove(index_);
+}
+
+GcRootHandle GcRootSet::addSlots(GcObject* const* slots, size_t count)
+{
+    return add({RootKind::Slots, slots, count});
+}
+
+GcRootHandle GcRootSet::addValues(const codegen::Value* values, size_t count)
+{
+    return add({RootKind::Values, values, count});
+}
+
+GcRootHandle GcRootSet::addStack(const codegen::Value* base, const codegen::Value* const* top)
+{
+    return add({RootKind::Stack, base, 0, top});
+}
+
+GcRootHandle GcRootSet::addCallback(RootTraceFn trace, void* context, RootTraceFn update)
+{
+    return add({RootKind::Callback, nullptr, 0, nullptr, trace, context, update});
+}
+
+size_t GcRootSet::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return roots_.size() - freeCount_;
+}
+
+GcRootHandle GcRootSet::add(Root root)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t                      index;
+    if (freeHead_ != SIZE_MAX)
+    {
+        index     = freeHead_;
+        freeHead_ = roots_[index].count;
+        --freeCount_;
+        roots_[index] = root;
+    }
+    else
+    {
+        index = roots_.size();
+        roots_.push_back(root);
+    }
+    return GcRootHandle(this, index);
+}
+
+void GcRootSet::remove(size_t index)
 {
-    sources_.push_back(std::move(cb));
+    std::lock_guard<std::mutex> lock(mutex_);
+    roots_[index] = {RootKind::Free, nullptr, freeHead_};
+    freeHead_     = index;
+    ++freeCount_;
 }
 
-void GcRootSet::removeSource(const TraceCallback* cb)
+void GcRootSet::traceAll(bool* pinning) const
 {
-    (void)cb;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto&                       heap = GcHeap::get();
+    for (const Root& root : roots_)
+    {
+        switch (root.kind)
+        {
+            case RootKind::Free:
+                break;
+            case RootKind::Slots:
+            {
+                auto* slots = static_cast<GcObject* const*>(root.data);
+                for (size_t i = 0; i < root.count; ++i) heap.markObject(slots[i]);
+                break;
+            }
+            case RootKind::Values:
+            {
+                auto* values = static_cast<const codegen::Value*>(root.data);
+                for (size_t i = 0; i < root.count; ++i) heap.markObject(values[i].gcRef());
+                break;
+            }
+            case RootKind::Stack:
+            {
+                auto* value = static_cast<const codegen::Value*>(root.data);
+                for (auto* top = *root.top; value < top; ++value) heap.markObject(value->gcRef());
+                break;
+            }
+            case RootKind::Callback:
+                if (pinning && !root.update)
+                {
+                    *pinning = true;
+                    root.trace(root.context);
+                    *pinning = false;
+                }
+                else
+                    root.trace(root.context);
+                break;
+        }
+    }
 }
 
-void GcRootSet::traceAll() const
+void GcRootSet::updateAll()
 {
-    for (const auto& src : sources_) src(nullptr);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto&                       heap = GcHeap::get();
+    for (Root& root : roots_)
+    {
+        // The ranges are registered read-only because tracing never writes them; they belong
+        // to the mutator, which expects a compaction to rewrite them.
+        switch (root.kind)
+        {
+            case RootKind::Free:
+                break;
+            case RootKind::Slots:
+            {
+                auto* slots = static_cast<GcObject**>(const_cast<void*>(root.data));
+                for (size_t i = 0; i < root.count; ++i) slots[i] = heap.forwarded(slots[i]);
+                break;
+            }
+            case RootKind::Values:
+            {
+                auto* values = static_cast<codegen::Value*>(const_cast<void*>(root.data));
+                for (size_t i = 0; i < root.count; ++i) values[i].updateGcRefs();
+                break;
+            }
+            case RootKind::Stack:
+            {
+                auto* value = static_cast<codegen::Value*>(const_cast<void*>(root.data));
+                for (auto* top = *root.top; value < top; ++value) value->updateGcRefs();
+                break;
+            }
+            case RootKind::Callback:
+                if (root.update)
+                    root.update(root.context);
+                break;
+        }
+    }
 }
 
 }  // namespace druk::gc
@@ -0,0 +1,35 @@
+#include "druk/gc/types/gc_shape.h"
+
+#include <mutex>
+
+namespace druk::gc
+{
+
+const GcShape* GcShape::empty()
+{
+    static const GcShape root;
+    return &root;
+}
+
+const GcShape* GcShape::with(std::string_view name) const
+{
+    // Shapes are shared by every thread, so growing the tree is serialised; a shape never
+    // changes once it is published.
+    static std::mutex           mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = transitions_.find(name);
+    if (it != transitions_.end())
+        return it->second.get();
+
+    std::unique_ptr<GcShape> child(new GcShape());
+    child->names_ = names_;
+    child->names_.emplace_back(name);
+    for (size_t slot = 0; slot < child->names_.size(); ++slot)
+        child->slots_.emplace(child->names_[slot], static_cast<uint32_t>(slot));
+
+    std::string_view key = child->names_.back();
+    return transitions_.emplace(key, std::move(child)).first->second.get();
+}
+
+}  // namespace druk::gc
@@ -0,0 +1,31 @@
+#include "druk/codegen/core/value.h"
+#include "druk/gc/gc_object.h"
+#include "druk/gc/types/gc_array.h"
+#include "druk/gc/types/gc_struct.h"
+
+namespace druk::gc
+{
+
+size_t payloadBytes(const GcObject* obj)
+{
+    switch (obj->kind)
+    {
+        case GcType::String:  // the characters live in the slot
+            return 0;
+        case GcType::Array:
+        {
+            const auto& elements = static_cast<const GcArray*>(obj)->elements;
+            return elements.spilled() ? elements.capacity() * sizeof(druk::codegen::Value) : 0;
+        }
+        case GcType::Struct:  // field names live in the shared shape
+        {
+            const auto& fields = static_cast<const GcStruct*>(obj)->fields;
+            return fields.spilled() ? fields.capacity() * sizeof(druk::codegen::Value) : 0;
+        }
+        case GcType::Function:
+            return 0;
+    }
+    return 0;
+}
+
+}  // namespace druk::gc
@@ -0,0 +1,27 @@
+#include "druk/gc/gc_stats.h"
+
+namespace druk::gc
+{
+
+void GcStats::print(std::ostream& out) const
+{
+    out << "GC collections: " << fullCollections << " full, " << minorCollections << " minor, "
+        << markIncrements << " incremental steps\n";
+    out << "GC pauses: " << pauses << ", total " << totalPauseUs << " us, max " << maxPauseUs
+        << " us\n";
+    out << "GC allocated " << bytesAllocated << " bytes, freed " << bytesFreed << " bytes in "
+        << objectsFreed << " objects\n";
+    if (compactions)
+        out << "GC compactions: " << compactions << ", moved " << objectsMoved << " objects\n";
+    out << "GC live: " << liveObjects << " objects, " << liveBytes << " bytes in "
+        << committedBytes << " bytes of pages\n";
+    for (size_t i = 0; i < kGcTypeCount; ++i)
+    {
+        if (liveObjectsByType[i] == 0)
+            continue;
+        out << "  " << gcTypeName(static_cast<GcType>(i)) << ": " << liveObjectsByType[i]
+            << " objects, " << liveBytesByType[i] << " bytes\n";
+    }
+}
+
+}  // namespace druk::gc
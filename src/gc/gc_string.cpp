@@ -1,8 +1,28 @@
 #include "druk/gc/types/gc_string.h"
 
+#include <cstring>
+#include <new>
+
 namespace druk::gc
 {
 
-void GcString::trace() {}
+GcString::GcString(std::string_view left, std::string_view right)
+    : GcObject(GcType::String), length_(static_cast<uint32_t>(left.size() + right.size()))
+{
+    char* out = mutableChars();
+    if (!left.empty())
+        std::memcpy(out, left.data(), left.size());
+    if (!right.empty())
+        std::memcpy(out + left.size(), right.data(), right.size());
+    out[length_] = '\0';
+}
+
+std::string immortalStringImage(std::string_view text)
+{
+    std::string image(GcString::allocationSize(text.size()), '\0');
+    auto*       str = new (image.data()) GcString(text, {});
+    str->immortal   = true;
+    return image;
+}
 
 }  // namespace druk::gc
@@ -0,0 +1,110 @@
+#include <algorithm>
+
+#include "druk/codegen/core/obj.h"
+#include "druk/codegen/core/value.h"
+#include "druk/gc/gc_heap.h"
+#include "druk/gc/types/gc_array.h"
+#include "druk/gc/types/gc_string.h"
+#include "druk/gc/types/gc_struct.h"
+
+namespace druk::gc
+{
+
+namespace
+{
+
+// An incremental step checks its deadline after this much work: one unit per object, or one
+// slice of a large array.
+constexpr size_t kClockInterval = 128;
+constexpr size_t kArraySlice    = 4096;
+
+size_t footprint(const GcObject* obj)
+{
+    // Functions are owned by the compiler and never counted against the heap.
+    if (obj->kind == GcType::Function)
+        return 0;
+    return GcPage::of(obj)->slotSize + payloadBytes(obj);
+}
+
+}  // namespace
+
+size_t GcHeap::traceObject(GcObject* obj, std::vector<GcObject*>& stack)
+{
+    switch (obj->kind)
+    {
+        case GcType::Array:
+            for (const auto& elem : static_cast<GcArray*>(obj)->elements)
+                markInto(elem.gcRef(), stack);
+            break;
+        case GcType::Struct:
+            for (const auto& field : static_cast<GcStruct*>(obj)->fields)
+                markInto(field.gcRef(), stack);
+            break;
+        case GcType::Function:
+            for (const auto& constant : static_cast<codegen::ObjFunction*>(obj)->chunk.constants())
+                markInto(constant.gcRef(), stack);
+            break;
+        case GcType::String:
+            break;
+    }
+    return footprint(obj);
+}
+
+void GcHeap::drainMarkStack()
+{
+    // Minor collections only trace the nursery, which is too small to repay starting workers.
+    if (markThreads_ > 1 && !minor_)
+    {
+        drainParallel();
+        return;
+    }
+    while (!markStack_.empty())
+    {
+        GcObject* obj = markStack_.back();
+        markStack_.pop_back();
+        markedBytes_ += traceObject(obj, markStack_);
+    }
+}
+
+void GcHeap::drainIncrement(std::chrono::steady_clock::time_point deadline)
+{
+    size_t work = 0;
+    while (partialArray_ || !markStack_.empty())
+    {
+        if (partialArray_)
+        {
+            // Elements stored behind the cursor meanwhile were shaded by the write barrier.
+            auto&  elements = static_cast<GcArray*>(partialArray_)->elements;
+            size_t end      = std::min(elements.size(), partialIndex_ + kArraySlice);
+            for (; partialIndex_ < end; ++partialIndex_)
+                markInto(elements[partialIndex_].gcRef(), markStack_);
+            if (partialIndex_ >= elements.size())
+                partialArray_ = nullptr;
+            work += kClockInterval;
+        }
+        else
+        {
+            GcObject* obj = markStack_.back();
+            markStack_.pop_back();
+            if (obj->kind == GcType::Array &&
+                static_cast<GcArray*>(obj)->elements.size() > kArraySlice)
+            {
+                partialArray_ = obj;
+                partialIndex_ = 0;
+                markedBytes_ += footprint(obj);
+                continue;
+            }
+            markedBytes_ += traceObject(obj, markStack_);
+            ++work;
+        }
+
+        if (work >= kClockInterval)
+        {
+            work = 0;
+            if (std::chrono::steady_clock::now() >= deadline)
+                return;
+        }
+    }
+}
+
+}  // namespace druk::gc
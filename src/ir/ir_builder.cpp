@@ -11,6 +11,7 @@ void IRBuilder::insert(std::unique_ptr<Instruction> inst)
 {
     if (insert_block_)
     {
+        inst->setLine(current_line_);
         insert_block_->appendInstruction(std::move(inst));
     }
 }
@@ -0,0 +1,38 @@
+#include "druk/ir/ir_builder.h"
+
+#include <utility>
+
+#include "druk/ir/ir_instruction_structs.h"
+
+namespace druk::ir
+{
+
+Instruction* IRBuilder::createBuildStruct(const gc::GcShape* shape,
+                                          const std::vector<Value*>& fields,
+                                          const std::string& name)
+{
+    auto inst = std::make_unique<BuildStructInst>(shape, fields);
+    inst->setName(name);
+    auto ptr = inst.get();
+    insert(std::move(inst));
+    return ptr;
+}
+
+Instruction* IRBuilder::createGetField(Value* object, std::string field, const std::string& name)
+{
+    auto inst = std::make_unique<GetFieldInst>(object, std::move(field));
+    inst->setName(name);
+    auto ptr = inst.get();
+    insert(std::move(inst));
+    return ptr;
+}
+
+Instruction* IRBuilder::createSetField(Value* object, std::string field, Value* value)
+{
+    auto inst = std::make_unique<SetFieldInst>(object, std::move(field), value);
+    auto ptr = inst.get();
+    insert(std::move(inst));
+    return ptr;
+}
+
+}  // namespace druk::ir
@@ -30,7 +30,10 @@ std::string LoadInst::toString() const
 
 std::shared_ptr<Type> LoadInst::getType() const
 {
-    return Type::getVoidTy();
+    // Loads from a typed local keep its type; parameters always arrive boxed.
+    if (auto* alloca = dynamic_cast<AllocaInst*>(getOperands()[0]))
+        return alloca->getAllocatedType();
+    return Type::getDynamicTy();
 }
 
 StoreInst::StoreInst(Value* val, Value* ptr) : Instruction(Opcode::Store)
@@ -16,9 +16,35 @@ std::string BinaryInst::toString() const
 
 std::shared_ptr<Type> BinaryInst::getType() const
 {
-    if (getOperands().empty())
+    if (getOperands().size() < 2)
         return Type::getVoidTy();
-    return getOperands()[0]->getType();
+
+    TypeID lhs   = getOperands()[0]->getType()->getID();
+    TypeID rhs   = getOperands()[1]->getType()->getID();
+    bool   ints  = lhs == TypeID::Int64 && rhs == TypeID::Int64;
+    bool   bools = lhs == TypeID::Bool && rhs == TypeID::Bool;
+
+    switch (getOpcode())
+    {
+        case Opcode::Add:
+        case Opcode::Sub:
+        case Opcode::Mul:
+            return ints ? Type::getInt64Ty() : Type::getDynamicTy();
+        case Opcode::Equal:
+        case Opcode::NotEqual:
+            return ints || bools ? Type::getBoolTy() : Type::getDynamicTy();
+        case Opcode::LessThan:
+        case Opcode::LessEqual:
+        case Opcode::GreaterThan:
+        case Opcode::GreaterEqual:
+            return ints ? Type::getBoolTy() : Type::getDynamicTy();
+        case Opcode::And:
+        case Opcode::Or:
+            return bools ? Type::getBoolTy() : Type::getDynamicTy();
+        default:
+            // Division yields nil on a zero divisor, so it always stays boxed.
+            return Type::getDynamicTy();
+    }
 }
 
 StringConcatInst::StringConcatInst(Value* l, Value* r) : Instruction(Opcode::StringConcat)
@@ -82,7 +108,12 @@ std::shared_ptr<Type> UnaryInst::getType() const
 {
     if (getOperands().empty())
         return Type::getVoidTy();
-    return getOperands()[0]->getType();
+    TypeID operand = getOperands()[0]->getType()->getID();
+    if (getOpcode() == Opcode::Neg && operand == TypeID::Int64)
+        return Type::getInt64Ty();
+    if (getOpcode() == Opcode::Not && operand == TypeID::Bool)
+        return Type::getBoolTy();
+    return Type::getDynamicTy();
 }
 
 }  // namespace druk::ir
@@ -0,0 +1,58 @@
+#include "druk/ir/ir_instruction_structs.h"
+
+#include <utility>
+
+namespace druk::ir
+{
+
+BuildStructInst::BuildStructInst(const gc::GcShape* shape, const std::vector<Value*>& fields)
+    : Instruction(Opcode::BuildStruct), shape_(shape)
+{
+    for (auto* field : fields)
+        addOperand(field);
+}
+
+std::string BuildStructInst::toString() const
+{
+    return "build_struct";
+}
+
+std::shared_ptr<Type> BuildStructInst::getType() const
+{
+    return Type::getVoidTy();
+}
+
+GetFieldInst::GetFieldInst(Value* object, std::string field)
+    : Instruction(Opcode::GetField), field_(std::move(field))
+{
+    addOperand(object);
+}
+
+std::string GetFieldInst::toString() const
+{
+    return "get_field";
+}
+
+std::shared_ptr<Type> GetFieldInst::getType() const
+{
+    return Type::getVoidTy();
+}
+
+SetFieldInst::SetFieldInst(Value* object, std::string field, Value* value)
+    : Instruction(Opcode::SetField), field_(std::move(field))
+{
+    addOperand(object);
+    addOperand(value);
+}
+
+std::string SetFieldInst::toString() const
+{
+    return "set_field";
+}
+
+std::shared_ptr<Type> SetFieldInst::getType() const
+{
+    return Type::getVoidTy();
+}
+
+}  // namespace druk::ir
@@ -46,4 +46,10 @@ std::shared_ptr<Type> Type::getBoolTy()
     return ty;
 }
 
+std::shared_ptr<Type> Type::getDynamicTy()
+{
+    static auto ty = std::make_shared<PrimitiveType>(TypeID::Dynamic, "dyn");
+    return ty;
+}
+
 }  // namespace druk::ir
@@ -5,6 +5,7 @@
 #include "druk/codegen/core/chunk.h"
 #include "druk/codegen/core/code_generator.h"
 #include "druk/codegen/llvm/llvm_codegen.h"
+#include "druk/gc/gc_heap.h"
 #include "druk/lexer/lexer.hpp"
 #include "druk/lexer/unicode.hpp"
 #include "druk/parser/core/parser.hpp"
@@ -81,6 +82,43 @@ std::vector<std::string> filter_args(int argc, char* argv[], bool& debug)
             debug = true;
             continue;
         }
+        if (arg.rfind("--gc-growth=", 0) == 0)
+        {
+            gc::GcHeap::get().setGrowthPercent(std::strtoull(arg.c_str() + 12, nullptr, 10));
+            continue;
+        }
+        if (arg.rfind("--gc-threads=", 0) == 0)
+        {
+            gc::GcHeap::get().setMarkThreads(std::strtoull(arg.c_str() + 13, nullptr, 10));
+            continue;
+        }
+        if (arg == "--gc-background-sweep")
+        {
+            gc::GcHeap::get().setBackgroundSweep(true);
+            continue;
+        }
+        if (arg.rfind("--gc-pause=", 0) == 0)
+        {
+            gc::GcHeap::get().setPauseBudget(std::strtoull(arg.c_str() + 11, nullptr, 10));
+            continue;
+        }
+        if (arg.rfind("--gc-compact=", 0) == 0)
+        {
+            gc::GcHeap::get().setCompactThreshold(std::strtoull(arg.c_str() + 13, nullptr, 10));
+            continue;
+        }
+        if (arg == "--gc-stats" || arg == "--gc-stats=verbose")
+        {
+            gc::GcHeap::get().setStatsLevel(arg == "--gc-stats" ? gc::GcStatsLevel::Summary
+                                                                : gc::GcStatsLevel::Verbose);
+            continue;
+        }
+        if (arg == "--heap-profile" || arg.rfind("--heap-profile=", 0) == 0)
+        {
+            size_t interval = arg.size() > 15 ? std::strtoull(arg.c_str() + 15, nullptr, 10) : 1;
+            gc::GcHeap::get().setHeapProfile(interval);
+            continue;
+        }
         args.emplace_back(std::move(arg));
     }
     return args;
@@ -107,6 +145,21 @@ int main(int argc, char* argv[])
         std::cout << "\nUsage: druk [path]                    (Run script)\n";
         std::cout << "       druk --vm [path]                (Run with VM interpreter)\n";
         std::cout << "       druk compile [path] -o [exe]    (Compile to executable)\n";
+        std::cout << "\nOptions:\n";
+        std::cout << "       --gc-growth=<percent>           (Heap growth between full GCs, "
+                     "default 100; env DRUK_GC_GROWTH)\n";
+        std::cout << "       --gc-threads=<n>                (Marking threads for full GCs, "
+                     "0 = all cores; env DRUK_GC_THREADS)\n";
+        std::cout << "       --gc-pause=<us>                 (Incremental marking step budget, "
+                     "0 = stop-the-world; env DRUK_GC_PAUSE_US)\n";
+        std::cout << "       --gc-background-sweep           (Sweep on a background thread; "
+                     "env DRUK_GC_BACKGROUND_SWEEP=1)\n";
+        std::cout << "       --gc-compact=<percent>          (Compact once this share of pages "
+                     "could be released, 0 = never; env DRUK_GC_COMPACT)\n";
+        std::cout << "       --gc-stats[=verbose]            (GC statistics on stderr at exit, "
+                     "verbose logs each full GC; env DRUK_GC_STATS=1|2)\n";
+        std::cout << "       --heap-profile[=<n>]            (Live bytes by allocation site every "
+                     "n full GCs and at exit; env DRUK_HEAP_PROFILE)\n";
 
         druk::util::printUpdateNotice(DRUK_VERSION);
         return 0;
@@ -66,10 +66,12 @@ ast::Expr* Parser::parseLambda()
     }
     else
     {
-        ast::Expr* expr  = parseExpression();
-        auto*      stmt  = arena_.make<ast::ExpressionStmt>();
-        stmt->kind       = ast::NodeKind::ExpressionStmt;
-        stmt->expression = expr;
+        lexer::Token start = peek();
+        ast::Expr*   expr  = parseExpression();
+        auto*        stmt  = arena_.make<ast::ExpressionStmt>();
+        stmt->kind         = ast::NodeKind::ExpressionStmt;
+        stmt->token        = start;
+        stmt->expression   = expr;
         body             = stmt;
     }
 
@@ -96,10 +98,12 @@ ast::Expr* Parser::parseLambdaFromIdentifier(lexer::Token name)
     }
     else
     {
-        ast::Expr* expr  = parseExpression();
-        auto*      stmt  = arena_.make<ast::ExpressionStmt>();
-        stmt->kind       = ast::NodeKind::ExpressionStmt;
-        stmt->expression = expr;
+        lexer::Token start = peek();
+        ast::Expr*   expr  = parseExpression();
+        auto*        stmt  = arena_.make<ast::ExpressionStmt>();
+        stmt->kind         = ast::NodeKind::ExpressionStmt;
+        stmt->token        = start;
+        stmt->expression   = expr;
         body             = stmt;
     }
 
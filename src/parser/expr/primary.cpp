@@ -91,8 +91,7 @@ ast::Expr* Parser::parsePrimary()
         expr->kind            = ast::NodeKind::Literal;
         expr->token           = previous();
         std::string_view text = expr->token.text(lexer_.source());
-        auto*            gs =
-            gc::GcHeap::get().alloc<gc::GcString>(std::string(text.substr(1, text.length() - 2)));
+        auto*            gs   = gc::GcHeap::get().allocString(text.substr(1, text.length() - 2));
         expr->literalValue = codegen::Value(gs);
         return expr;
     }
@@ -107,8 +106,8 @@ ast::Expr* Parser::parsePrimary()
 
         // Add the first part (excluding opening quote, including braces? Lexer gave `"Hello {`)
         std::string_view first_text = expr->token.text(lexer_.source());
-        auto*            gs_first   = gc::GcHeap::get().alloc<gc::GcString>(
-            std::string(first_text.substr(1, first_text.length() - 2)));
+        auto*            gs_first =
+            gc::GcHeap::get().allocString(first_text.substr(1, first_text.length() - 2));
         auto* first_lit         = arena_.make<ast::LiteralExpr>();
         first_lit->kind         = ast::NodeKind::Literal;
         first_lit->literalValue = codegen::Value(gs_first);
@@ -122,8 +121,8 @@ ast::Expr* Parser::parsePrimary()
             if (match(lexer::TokenType::InterpolatedStringPart))
             {
                 std::string_view part_text = previous().text(lexer_.source());
-                auto*            gs_part   = gc::GcHeap::get().alloc<gc::GcString>(std::string(
-                    part_text.substr(1, part_text.length() - 2)));  // e.g., `} are {` -> ` are `
+                auto*            gs_part   = gc::GcHeap::get().allocString(
+                    part_text.substr(1, part_text.length() - 2));  // e.g., `} are {` -> ` are `
                 auto*            lit       = arena_.make<ast::LiteralExpr>();
                 lit->kind                  = ast::NodeKind::Literal;
                 lit->literalValue          = codegen::Value(gs_part);
@@ -132,8 +131,8 @@ ast::Expr* Parser::parsePrimary()
             else if (match(lexer::TokenType::InterpolatedStringEnd))
             {
                 std::string_view end_text = previous().text(lexer_.source());
-                auto* gs_end = gc::GcHeap::get().alloc<gc::GcString>(std::string(end_text.substr(
-                    1, end_text.length() - 2)));  // e.g., `} years old!"` -> ` years old!`
+                auto* gs_end = gc::GcHeap::get().allocString(end_text.substr(
+                    1, end_text.length() - 2));  // e.g., `} years old!"` -> ` years old!`
                 auto* lit    = arena_.make<ast::LiteralExpr>();
                 lit->kind    = ast::NodeKind::Literal;
                 lit->literalValue = codegen::Value(gs_end);
@@ -34,9 +34,8 @@ ast::Stmt* Parser::parseStatement()
 ast::Stmt* Parser::parseBlock()
 {
     auto* block = arena_.make<ast::BlockStmt>();
-    block->kind = ast::NodeKind::Block;
-
-    consume(lexer::TokenType::LBrace, "Expect '{' before block.");
+    block->kind  = ast::NodeKind::Block;
+    block->token = consume(lexer::TokenType::LBrace, "Expect '{' before block.");
 
     std::vector<ast::Stmt*> stmts;
     while (!check(lexer::TokenType::RBrace) && !isAtEnd())
@@ -75,20 +74,24 @@ ast::Stmt* Parser::parseBlock()
 
 ast::Stmt* Parser::parseExpressionStatement()
 {
-    ast::Expr* expr = parseExpression();
+    lexer::Token start = peek();
+    ast::Expr*   expr  = parseExpression();
     consume(lexer::TokenType::Semicolon, "Expect ';' after expression.");
     auto* stmt       = arena_.make<ast::ExpressionStmt>();
     stmt->kind       = ast::NodeKind::ExpressionStmt;
+    stmt->token      = start;
     stmt->expression = expr;
     return stmt;
 }
 
 ast::Stmt* Parser::parsePrintStatement()
 {
-    ast::Expr* expr = parseExpression();
+    lexer::Token keyword = previous();
+    ast::Expr*   expr    = parseExpression();
     consume(lexer::TokenType::Semicolon, "Expect ';' after value.");
     auto* stmt       = arena_.make<ast::PrintStmt>();
     stmt->kind       = ast::NodeKind::Print;
+    stmt->token      = keyword;
     stmt->expression = expr;
     return stmt;
 }
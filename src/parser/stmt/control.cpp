@@ -5,6 +5,7 @@ namespace druk::parser
 
 ast::Stmt* Parser::parseIfStatement()
 {
+    lexer::Token keyword = previous();
     consume(lexer::TokenType::LParen, "Expect '(' after 'if'.");
     ast::Expr* condition = parseExpression();
     consume(lexer::TokenType::RParen, "Expect ')' after if condition.");
@@ -26,6 +27,7 @@ ast::Stmt* Parser::parseIfStatement()
 
     auto* stmt       = arena_.make<ast::IfStmt>();
     stmt->kind       = ast::NodeKind::If;
+    stmt->token      = keyword;
     stmt->condition  = condition;
     stmt->thenBranch = thenBranch;
     stmt->elseBranch = elseBranch;
@@ -34,6 +36,7 @@ ast::Stmt* Parser::parseIfStatement()
 
 ast::Stmt* Parser::parseLoopStatement()
 {
+    lexer::Token keyword = previous();
     consume(lexer::TokenType::LParen, "Expect '(' after 'loop'.");
     ast::Expr* condition = parseExpression();
     consume(lexer::TokenType::RParen, "Expect ')' after loop condition.");
@@ -42,6 +45,7 @@ ast::Stmt* Parser::parseLoopStatement()
 
     auto* stmt      = arena_.make<ast::LoopStmt>();
     stmt->kind      = ast::NodeKind::Loop;
+    stmt->token     = keyword;
     stmt->condition = condition;
     stmt->body      = body;
     return stmt;
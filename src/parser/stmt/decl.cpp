@@ -26,7 +26,8 @@ ast::Stmt* Parser::parseDeclaration()
 
 ast::Stmt* Parser::parseFunction()
 {
-    lexer::Token name = consume(lexer::TokenType::Identifier, "Expect function name.");
+    lexer::Token keyword = previous();
+    lexer::Token name    = consume(lexer::TokenType::Identifier, "Expect function name.");
     consume(lexer::TokenType::LParen, "Expect '(' after function name.");
     std::vector<ast::Param> params;
     if (!check(lexer::TokenType::RParen))
@@ -46,6 +47,7 @@ ast::Stmt* Parser::parseFunction()
     ast::Stmt* body  = parseBlock();
     auto*      func  = arena_.make<ast::FuncDecl>();
     func->kind       = ast::NodeKind::Function;
+    func->token      = keyword;
     func->name       = name;
     func->body       = body;
     func->returnType = returnType;
@@ -65,6 +67,7 @@ ast::Stmt* Parser::parseFunction()
 
 ast::Stmt* Parser::parseVarDeclaration()
 {
+    lexer::Token start       = peek();
     ast::Type*   type        = parseType();
     lexer::Token name        = consume(lexer::TokenType::Identifier, "Expect variable name.");
     ast::Expr*   initializer = nullptr;
@@ -73,6 +76,7 @@ ast::Stmt* Parser::parseVarDeclaration()
     consume(lexer::TokenType::Semicolon, "Expect ';' after variable declaration.");
     auto* var        = arena_.make<ast::VarDecl>();
     var->kind        = ast::NodeKind::Variable;
+    var->token       = start;
     var->name        = name;
     var->initializer = initializer;
     var->type        = type;
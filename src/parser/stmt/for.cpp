@@ -5,6 +5,7 @@ namespace druk::parser
 
 ast::Stmt* Parser::parseForStatement()
 {
+    lexer::Token keyword = previous();
     consume(lexer::TokenType::LParen, "Expect '(' after for.");
 
     ast::Stmt* init = nullptr;
@@ -36,6 +37,7 @@ ast::Stmt* Parser::parseForStatement()
 
     auto* stmt      = arena_.make<ast::ForStmt>();
     stmt->kind      = ast::NodeKind::For;
+    stmt->token     = keyword;
     stmt->init      = init;
     stmt->condition = condition;
     stmt->step      = step;
@@ -6,7 +6,8 @@ namespace druk::parser
 
 ast::Stmt* Parser::parseMatchStatement()
 {
-    ast::Expr* expression = parseExpression();
+    lexer::Token keyword    = previous();
+    ast::Expr*   expression = parseExpression();
     consume(lexer::TokenType::LBrace, "Expect '{' before match arms.");
 
     std::vector<ast::MatchArm> arms;
@@ -30,6 +31,7 @@ ast::Stmt* Parser::parseMatchStatement()
 
     auto* stmt       = arena_.make<ast::MatchStmt>();
     stmt->kind       = ast::NodeKind::Match;
+    stmt->token      = keyword;
     stmt->expression = expression;
     stmt->armCount   = static_cast<uint32_t>(arms.size());
     stmt->arms       = arena_.makeArray<ast::MatchArm>(stmt->armCount);
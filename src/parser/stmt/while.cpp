@@ -5,6 +5,7 @@ namespace druk::parser
 
 ast::Stmt* Parser::parseWhileStatement()
 {
+    lexer::Token keyword = previous();
     consume(lexer::TokenType::LParen, "Expect '(' after while.");
     ast::Expr* condition = parseExpression();
     consume(lexer::TokenType::RParen, "Expect ')' after while condition.");
@@ -13,6 +14,7 @@ ast::Stmt* Parser::parseWhileStatement()
 
     auto* stmt      = arena_.make<ast::WhileStmt>();
     stmt->kind      = ast::NodeKind::While;
+    stmt->token     = keyword;
     stmt->condition = condition;
     stmt->body      = body;
     return stmt;
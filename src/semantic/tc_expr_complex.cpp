@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <memory>
+
 #include "druk/parser/ast/expr.hpp"
 #include "druk/parser/ast/lambda.hpp"
 #include "druk/parser/ast/stmt.hpp"
@@ -77,16 +80,33 @@ void TypeChecker::visitIndex(parser::ast::IndexExpr* expr)
 
 void TypeChecker::visitStructLiteral(parser::ast::StructLiteralExpr* expr)
 {
-    for (uint32_t i = 0; i < expr->fieldCount; ++i) analyze(expr->fieldValues[i]);
-    currentType_ = Type::makeStruct({});
+    // The fields keep their source order: code generation lays the struct out from this type.
+    std::vector<StructField> fields;
+    for (uint32_t i = 0; i < expr->fieldCount; ++i)
+    {
+        auto name = std::string(expr->fieldNames[i].text(source_));
+        Type type = analyze(expr->fieldValues[i]);
+        if (std::any_of(fields.begin(), fields.end(),
+                        [&](const StructField& field) { return field.name == name; }))
+            error(expr->fieldNames[i], "Duplicate field '" + name + "' in struct literal.");
+        else
+            fields.push_back({std::move(name), std::make_shared<Type>(type)});
+    }
+    currentType_ = Type::makeStruct(std::move(fields));
     expr->type   = currentType_;
 }
 
 void TypeChecker::visitMemberAccess(parser::ast::MemberAccessExpr* expr)
 {
-    analyze(expr->object);
+    Type objType = analyze(expr->object);
+    auto name    = expr->memberName.text(source_);
+    // Optimistic, like calls and indexing, when the struct is not known statically.
     currentType_ = Type::makeInt();
-    expr->type   = currentType_;
+    if (objType.kind == TypeKind::Struct)
+        for (const auto& field : objType.fields)
+            if (field.name == name && field.type)
+                currentType_ = *field.type;
+    expr->type = currentType_;
 }
 
 }  // namespace druk::semantic
@@ -91,10 +91,16 @@ void TypeChecker::visitBinary(parser::ast::BinaryExpr* expr)
             currentType_ = Type::makeInt();
         }
     }
+    else if (left == Type::makeString() && right == Type::makeString() &&
+             expr->token.type == lexer::TokenType::Plus)
+    {
+        currentType_ = Type::makeString();
+    }
     else
     {
         currentType_ = Type::makeError();
     }
+    expr->type = currentType_;
 }
 
 void TypeChecker::visitInterpolatedStringExpr(parser::ast::InterpolatedStringExpr* expr)
@@ -7,8 +7,10 @@
 #include <memory>
 #include <string>
 
+#include "druk/codegen/core/global_slots.h"
 #include "druk/codegen/core/opcode.h"
 #include "druk/gc/gc_heap.h"
+#include "druk/gc/gc_mutator.h"
 #include "druk/gc/types/gc_array.h"
 #include "druk/gc/types/gc_string.h"
 #include "druk/gc/types/gc_struct.h"
@@ -29,10 +31,30 @@ VM::VM()
     stackBase_ = stack_.data();
     stackTop_  = stackBase_;
     frames_.reserve(64);
+
+    auto& roots = gc::GcHeap::get().roots();
+    stackRoot_  = roots.addStack(stackBase_, &stackTop_);
+    stateRoot_  = roots.addCallback(&VM::traceRoots, this, &VM::updateRoots);
 }
 
 VM::~VM() {}
 
+void VM::traceRoots(void* vm)
+{
+    auto& self = *static_cast<VM*>(vm);
+    auto& heap = gc::GcHeap::get();
+    for (const auto& frame : self.frames_) heap.markObject(frame.function);
+    for (const auto& global : self.globals_) global.value.markGcRefs();
+    self.lastResult_.markGcRefs();
+}
+
+void VM::updateRoots(void* vm)
+{
+    auto& self = *static_cast<VM*>(vm);
+    for (auto& global : self.globals_) global.value.updateGcRefs();
+    self.lastResult_.updateGcRefs();
+}
+
 void VM::set_args(const std::vector<std::string>& args)
 {
     argvStorage_ = args;
@@ -41,23 +63,12 @@ void VM::set_args(const std::vector<std::string>& args)
     argvArray->elements.reserve(argvStorage_.size());
     for (const auto& s : argvStorage_)
     {
-        auto* gs = gc::GcHeap::get().alloc<gc::GcString>(s);
+        auto* gs = gc::GcHeap::get().allocString(s);
         argvArray->elements.push_back(Value(gs));
     }
 
     auto set_global = [&](std::string_view name, Value value)
-    {
-        auto it = globals_.find(name);
-        if (it == globals_.end())
-        {
-            globals_.emplace(name, std::move(value));
-            globalsVersion_++;
-        }
-        else
-        {
-            it->second = std::move(value);
-        }
-    };
+    { global(globalSlot(name)) = {std::move(value), true}; };
 
     set_global("argv", Value(argvArray));
     set_global("argc", Value(static_cast<int64_t>(argvStorage_.size())));
@@ -65,8 +76,16 @@ void VM::set_args(const std::vector<std::string>& args)
     set_global("ནང་འཇུག་གྲངས་", Value(static_cast<int64_t>(argvStorage_.size())));
 }
 
+VM::Global& VM::global(uint32_t slot)
+{
+    if (slot >= globals_.size())
+        globals_.resize(slot + 1);
+    return globals_[slot];
+}
+
 InterpretResult VM::interpret(ObjFunction* function)
 {
+    gc::GcMutatorScope mutator;
     stackTop_ = stackBase_;
     frames_.clear();
     lastResult_ = Value();
@@ -129,9 +148,9 @@ void VM::runtimeError(const char* format, ...)
     stackTop_ = stackBase_;
 }
 
-gc::GcString* VM::storeString(std::string value)
+gc::GcString* VM::storeString(std::string_view value)
 {
-    return gc::GcHeap::get().alloc<gc::GcString>(std::move(value));
+    return gc::GcHeap::get().allocString(value);
 }
 
 InterpretResult VM::run()
@@ -227,80 +246,47 @@ InterpretResult VM::run()
 
             case OpCode::GetGlobal:
             {
-                Value            nameVal = READ_CONSTANT();
-                std::string_view name    = nameVal.asString();
-                if (globalCache_.slot && globalCache_.version == globalsVersion_ &&
-                    globalCache_.name == name)
-                {
-                    push(*globalCache_.slot);
-                }
-                else
+                uint8_t  index = READ_BYTE();
+                uint32_t slot  = frame_->function->chunk.globalSlotAt(index);
+                if (slot >= globals_.size() || !globals_[slot].defined)
                 {
-                    auto it = globals_.find(name);
-                    if (it == globals_.end())
-                    {
-                        frame_->ip = ip;
-                        runtimeError("Undefined variable '%.*s'.", static_cast<int>(name.length()),
-                                     name.data());
-                        return InterpretResult::RuntimeError;
-                    }
-                    globalCache_.name    = name;
-                    globalCache_.slot    = &it->second;
-                    globalCache_.version = globalsVersion_;
-                    push(it->second);
+                    frame_->ip            = ip;
+                    std::string_view name = frame_->function->chunk.constants()[index].asString();
+                    runtimeError("Undefined variable '%.*s'.", static_cast<int>(name.length()),
+                                 name.data());
+                    return InterpretResult::RuntimeError;
                 }
+                push(globals_[slot].value);
                 break;
             }
 
             case OpCode::DefineGlobal:
             {
-                Value            nameVal = READ_CONSTANT();
-                std::string_view name    = nameVal.asString();
-                Value            value   = pop();
-                auto             it      = globals_.find(name);
-                if (it == globals_.end())
-                {
-                    auto [new_it, inserted] = globals_.emplace(name, std::move(value));
-                    it                      = new_it;
-                    if (inserted)
-                    {
-                        globalsVersion_++;
-                    }
-                }
-                else
+                uint8_t  index = READ_BYTE();
+                uint32_t slot  = frame_->function->chunk.globalSlotAt(index);
+                if (slot == Chunk::kUnresolvedSlot)
                 {
-                    it->second = std::move(value);
+                    frame_->ip = ip;
+                    runtimeError("Global name must be a string.");
+                    return InterpretResult::RuntimeError;
                 }
-                globalCache_.name    = name;
-                globalCache_.slot    = &it->second;
-                globalCache_.version = globalsVersion_;
+                global(slot) = {pop(), true};
                 break;
             }
 
             case OpCode::SetGlobal:
             {
-                Value            nameVal = READ_CONSTANT();
-                std::string_view name    = nameVal.asString();
-                if (globalCache_.slot && globalCache_.version == globalsVersion_ &&
-                    globalCache_.name == name)
+                uint8_t  index = READ_BYTE();
+                uint32_t slot  = frame_->function->chunk.globalSlotAt(index);
+                if (slot >= globals_.size() || !globals_[slot].defined)
                 {
-                    *globalCache_.slot = peek(0);
-                }
-                else
-                {
-                    auto it = globals_.find(name);
-                    if (it == globals_.end())
-                    {
-                        frame_->ip = ip;
-                        runtimeError("Undefined variable '%.*s'.", static_cast<int>(name.length()),
-                                     name.data());
-                        return InterpretResult::RuntimeError;
-                    }
-                    it->second           = peek(0);
-                    globalCache_.name    = name;
-                    globalCache_.slot    = &it->second;
-                    globalCache_.version = globalsVersion_;
+                    frame_->ip            = ip;
+                    std::string_view name = frame_->function->chunk.constants()[index].asString();
+                    runtimeError("Undefined variable '%.*s'.", static_cast<int>(name.length()),
+                                 name.data());
+                    return InterpretResult::RuntimeError;
                 }
+                globals_[slot].value = peek(0);
                 break;
             }
 
@@ -429,6 +415,7 @@ InterpretResult VM::run()
             {
                 uint16_t offset = READ_SHORT();
                 ip -= offset;
+                gc::GcHeap::get().safepoint();
                 break;
             }
 
@@ -438,6 +425,7 @@ InterpretResult VM::run()
 
             case OpCode::Call:
             {
+                gc::GcHeap::get().safepoint();
                 uint8_t      argCount = READ_BYTE();
                 const Value& callee   = peek(argCount);
                 if (!callee.isFunction())
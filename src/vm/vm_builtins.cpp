@@ -34,7 +34,11 @@ case OpCode::Push:
             runtimeError("push() requires array as first argument.");
             return InterpretResult::RuntimeError;
         }
-        arrayVal.asGcArray()->elements.push_back(element);
+        auto* array = arrayVal.asGcArray();
+        size_t had = gc::payloadBytes(array);
+        array->elements.push_back(element);
+        gc::GcHeap::get().writeBarrier(array, element.gcRef());
+        gc::GcHeap::get().notifyGrowth(array, gc::payloadBytes(array) - had);
         push(Value());
     }
     break;
@@ -96,10 +100,10 @@ case OpCode::Keys:
         }
         auto* obj = objVal.asGcStruct();
         auto* keys = gc::GcHeap::get().alloc<gc::GcArray>();
-        keys->elements.reserve(obj->fields.size());
-        for (const auto& pair : obj->fields)
+        keys->elements.reserve(obj->size());
+        for (const auto& name : obj->shape->names())
         {
-            keys->elements.push_back(Value(storeString(pair.first)));
+            keys->elements.push_back(Value(storeString(name)));
         }
         push(Value(keys));
     }
@@ -118,10 +122,10 @@ case OpCode::Values:
         }
         auto* obj = objVal.asGcStruct();
         auto* values = gc::GcHeap::get().alloc<gc::GcArray>();
-        values->elements.reserve(obj->fields.size());
-        for (const auto& pair : obj->fields)
+        values->elements.reserve(obj->size());
+        for (const auto& field : obj->fields)
         {
-            values->elements.push_back(pair.second);
+            values->elements.push_back(field);
         }
         push(Value(values));
     }
@@ -153,7 +157,7 @@ case OpCode::Contains:
             if (!needle.isString())
                 push(Value(false));
             else
-                push(Value(obj->fields.find(std::string(needle.asString())) != obj->fields.end()));
+                push(Value(obj->find(needle.asString()) != nullptr));
         }
         else
         {
@@ -169,10 +173,15 @@ case OpCode::Input:
 {
     {
         std::string line;
-        if (!std::getline(std::cin, line))
+        bool        read;
+        {
+            gc::GcNativeScope blocking;  // other threads may collect while this one waits
+            read = static_cast<bool>(std::getline(std::cin, line));
+        }
+        if (!read)
             push(Value());
         else
-            push(Value(storeString(std::move(line))));
+            push(Value(storeString(line)));
     }
     break;
 }
@@ -7,6 +7,7 @@ case OpCode::BuildArray:
         uint8_t count = READ_BYTE();
         auto* array = gc::GcHeap::get().alloc<gc::GcArray>();
         array->elements.resize(count);
+        gc::GcHeap::get().notifyGrowth(array, gc::payloadBytes(array));
         for (int i = count - 1; i >= 0; --i)
         {
             array->elements[static_cast<size_t>(i)] = pop();
@@ -73,6 +74,7 @@ case OpCode::IndexSet:
             return InterpretResult::RuntimeError;
         }
         array->elements[static_cast<size_t>(index)] = value;
+        gc::GcHeap::get().writeBarrier(array, value.gcRef());
         push(value);
     }
     break;
@@ -83,18 +85,20 @@ case OpCode::BuildStruct:
     {
         uint8_t fieldCount = READ_BYTE();
         auto* obj = gc::GcHeap::get().alloc<gc::GcStruct>();
+        // Fields are added in source order, so structs built by the same literal share a shape.
         for (int i = fieldCount - 1; i >= 0; --i)
         {
-            Value value = pop();
-            Value nameVal = pop();
+            const Value& nameVal = peek(2 * i + 1);
             if (!nameVal.isString())
             {
                 frame_->ip = ip;
                 runtimeError("Struct field name must be a string.");
                 return InterpretResult::RuntimeError;
             }
-            obj->fields[std::string(nameVal.asString())] = value;
+            obj->set(nameVal.asString(), peek(2 * i));
         }
+        gc::GcHeap::get().notifyGrowth(obj, gc::payloadBytes(obj));
+        stackTop_ -= 2 * fieldCount;
         push(Value(obj));
     }
     break;
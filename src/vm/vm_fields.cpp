@@ -13,22 +13,26 @@ case OpCode::GetField:
             return InterpretResult::RuntimeError;
         }
         auto* obj = objVal.asGcStruct();
-        Value nameConstant = frame_->function->chunk.constants()[nameIndex];
-        if (!nameConstant.isString())
+        auto& cache = frame_->function->chunk.fieldCacheAt(nameIndex);
+        if (cache.shape != obj->shape)
         {
-            frame_->ip = ip;
-            runtimeError("Field name must be a string.");
-            return InterpretResult::RuntimeError;
-        }
-        std::string name(nameConstant.asString());
-        auto it = obj->fields.find(name);
-        if (it == obj->fields.end())
-        {
-            frame_->ip = ip;
-            runtimeError("Undefined field '%s'.", name.c_str());
-            return InterpretResult::RuntimeError;
+            Value nameConstant = frame_->function->chunk.constants()[nameIndex];
+            if (!nameConstant.isString())
+            {
+                frame_->ip = ip;
+                runtimeError("Field name must be a string.");
+                return InterpretResult::RuntimeError;
+            }
+            uint32_t slot = obj->shape->slotOf(nameConstant.asString());
+            if (slot == gc::GcShape::kNoSlot)
+            {
+                frame_->ip = ip;
+                runtimeError("Undefined field '%s'.", std::string(nameConstant.asString()).c_str());
+                return InterpretResult::RuntimeError;
+            }
+            cache = {obj->shape, slot};
         }
-        push(it->second);
+        push(obj->fields[cache.slot]);
     }
     break;
 }
@@ -46,14 +50,29 @@ case OpCode::SetField:
             return InterpretResult::RuntimeError;
         }
         auto* obj = objVal.asGcStruct();
-        Value nameConstant = frame_->function->chunk.constants()[nameIndex];
-        if (!nameConstant.isString())
+        size_t had = gc::payloadBytes(obj);
+        auto& cache = frame_->function->chunk.fieldCacheAt(nameIndex);
+        if (cache.shape == obj->shape)
         {
-            frame_->ip = ip;
-            runtimeError("Field name must be a string.");
-            return InterpretResult::RuntimeError;
+            obj->fields[cache.slot] = value;
+        }
+        else
+        {
+            Value nameConstant = frame_->function->chunk.constants()[nameIndex];
+            if (!nameConstant.isString())
+            {
+                frame_->ip = ip;
+                runtimeError("Field name must be a string.");
+                return InterpretResult::RuntimeError;
+            }
+            // A new field changes the struct's shape, so only existing fields are cached.
+            uint32_t slot = obj->shape->slotOf(nameConstant.asString());
+            if (slot != gc::GcShape::kNoSlot)
+                cache = {obj->shape, slot};
+            obj->set(nameConstant.asString(), value);
         }
-        obj->fields[std::string(nameConstant.asString())] = value;
+        gc::GcHeap::get().writeBarrier(obj, value.gcRef());
+        gc::GcHeap::get().notifyGrowth(obj, gc::payloadBytes(obj) - had);
         push(value);
     }
     break;
@@ -0,0 +1,56 @@
+#pragma once
+
+// ─── JIT test utilities ───────────────────────────────────────────────────────
+// For tests linked against druk-core with LLVM. It provides:
+//   - JitProgram: lex + parse + analyze + IR + JIT-compile, then run the entry
+
+#include <cstdint>
+#include <string_view>
+
+#include "druk/codegen/core/code_generator.h"
+#include "druk/codegen/jit/jit_runtime.h"
+#include "druk/codegen/llvm/llvm_backend.h"
+#include "druk/gc/gc_mutator.h"
+#include "druk/ir/ir_module.h"
+#include "helpers/test_helpers.h"
+
+
+namespace druk::test
+{
+
+// ─── JitProgram ───────────────────────────────────────────────────────────────
+// Compiles a whole program; `entry` stays null if any phase fails. run() executes it on the
+// calling thread and returns what the program returned, as an int.
+struct JitProgram
+{
+    SemanticHelper                     sh;
+    ir::Module                         module{"main"};
+    codegen::LLVMBackend               backend;
+    codegen::LLVMBackend::CompiledFunc entry = nullptr;
+
+    explicit JitProgram(std::string_view src)
+    {
+        parser::Parser p(src, sh.arena, sh.interner, sh.errors);
+        auto           stmts = p.parse();
+        if (sh.errors.hasErrors())
+            return;
+        semantic::Analyzer analyzer(sh.errors, sh.interner, src);
+        if (!analyzer.analyze(stmts))
+            return;
+        codegen::CodeGenerator generator(module, sh.errors, src);
+        if (generator.generate(stmts) && !sh.errors.hasErrors())
+            entry = backend.compileFunction(module.getFunction("main"));
+    }
+
+    int64_t run() const
+    {
+        PackedValue result{};
+        {
+            gc::GcMutatorScope mutator;
+            entry(&result);
+        }
+        return druk_jit_value_as_int(&result);
+    }
+};
+
+}  // namespace druk::test
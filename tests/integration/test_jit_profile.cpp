@@ -0,0 +1,43 @@
+// test_jit_profile.cpp — Integration: allocation sites that JIT-compiled code reports to the heap profile
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "druk/gc/gc_heap.h"
+#include "helpers/jit_helpers.h"
+
+
+using namespace druk;
+using namespace druk::test;
+
+// ─── Sites ────────────────────────────────────────────────────────────────────
+
+TEST(JitProfileTest, AllocationsReportTheirOwnLines)
+{
+    auto& heap = gc::GcHeap::get();
+    heap.collect();
+    heap.setHeapProfile(1);
+
+    // Each array is the only allocation on its line. The ones in main come after a call into
+    // site_g, which sets a site of its own, and the last shares its line with that call.
+    JitProgram program(
+        "ལས་འགན་ site_g(གྲངས་ i) {\n"
+        "    སླར་ལོག་ [i, i];\n"
+        "}\n"
+        "གྲངས་ n = site_g(༡)[༠];\n"
+        "གྲངས་ a = [n, n, n];\n"
+        "གྲངས་ b = [site_g(༢)[༠], ༣, ༤];\n"
+        "སླར་ལོག་ ༠;\n");
+    ASSERT_NE(program.entry, nullptr);
+    EXPECT_EQ(program.run(), 0);
+
+    std::ostringstream out;
+    heap.printHeapProfile(out, "in test");
+    heap.setHeapProfile(0);
+    std::string report = out.str();
+    EXPECT_NE(report.find("2 objects  site_g:2 (array 2)"), std::string::npos) << report;
+    EXPECT_NE(report.find("1 objects  main:5 (array 1)"), std::string::npos) << report;
+    EXPECT_NE(report.find("1 objects  main:6 (array 1)"), std::string::npos) << report;
+    EXPECT_EQ(report.find("main:1"), std::string::npos) << report;
+}
@@ -0,0 +1,41 @@
+// test_jit_structs.cpp — Integration: JIT-compiled struct field access
+#include <gtest/gtest.h>
+
+#include "helpers/jit_helpers.h"
+
+
+using namespace druk::test;
+
+// ─── Cached field reads ───────────────────────────────────────────────────────
+
+TEST(JitStructsTest, CachedReadOfFalseField)
+{
+    // The runtime stores the false; every read after the first hits the site's cache and copies
+    // the field's raw bytes.
+    JitProgram program(
+        "ལས་འགན་ off(གྲངས་ p) -> གྲངས་ {"
+        "    p.on = p.n > ༡༠༠;"
+        "    གལ་སྲིད་ (p.on) { སླར་ལོག་ ༡; }"
+        "    སླར་ལོག་ ༠;"
+        "}"
+        "གྲངས་ hits = ༠;"
+        "རེ་རེར་ (གྲངས་ i = ༠; i < ༡༠; i = i + ༡) { hits = hits + off({on: བདེན་པ་, n: i}); }"
+        "སླར་ལོག་ hits;");
+    ASSERT_NE(program.entry, nullptr);
+    EXPECT_EQ(program.run(), 0);
+}
+
+TEST(JitStructsTest, CachedReadOfTrueField)
+{
+    JitProgram program(
+        "ལས་འགན་ on(གྲངས་ p) -> གྲངས་ {"
+        "    p.on = p.n < ༡༠༠;"
+        "    གལ་སྲིད་ (p.on) { སླར་ལོག་ ༡; }"
+        "    སླར་ལོག་ ༠;"
+        "}"
+        "གྲངས་ hits = ༠;"
+        "རེ་རེར་ (གྲངས་ i = ༠; i < ༡༠; i = i + ༡) { hits = hits + on({on: རྫུན་མ་, n: i}); }"
+        "སླར་ལོག་ hits;");
+    ASSERT_NE(program.entry, nullptr);
+    EXPECT_EQ(program.run(), 10);
+}
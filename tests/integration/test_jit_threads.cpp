@@ -0,0 +1,82 @@
+// test_jit_threads.cpp — Integration: JIT-compiled programs running on several threads at once
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "druk/gc/gc_heap.h"
+#include "helpers/jit_helpers.h"
+
+
+using namespace druk;
+using namespace druk::test;
+
+// ─── Helpers ──────────────────────────────────────────────────────────────────
+
+// Sums i + 1 for i below n, allocating an array per step and calling through a function
+// value, so both the argument stack and the root frames are busy across collections. `tag`
+// keeps each program's names its own.
+std::string allocatingSum(const std::string& tag, const std::string& n)
+{
+    return "ལས་འགན་ pair_" + tag + "(གྲངས་ n) { སླར་ལོག་ [n, n + ༡]; }" +
+           "ལས་འགན་ second_" + tag + "(གྲངས་ n) { སླར་ལོག་ pair_" + tag + "(n)[༡]; }" +
+           "ལས་འགན་ apply_" + tag + "(ལས་འགན་(གྲངས་) -> གྲངས་ f, གྲངས་ x) { སླར་ལོག་ f(x); }" +
+           "གྲངས་ total_" + tag + " = ༠;" +
+           "རེ་རེར་ (གྲངས་ i = ༠; i < " + n + "; i = i + ༡) {" +
+           "    total_" + tag + " = total_" + tag + " + apply_" + tag + "(second_" + tag + ", i);" +
+           "}" +
+           "སླར་ལོག་ total_" + tag + ";";
+}
+
+// ─── Two threads ──────────────────────────────────────────────────────────────
+
+TEST(JitThreadsTest, TwoThreadsAllocateThroughCollections)
+{
+    JitProgram first(allocatingSum("a", "༢༠༠༠༠༠"));
+    JitProgram second(allocatingSum("b", "༡༥༠༠༠༠"));
+    ASSERT_NE(first.entry, nullptr);
+    ASSERT_NE(second.entry, nullptr);
+
+    size_t  collections = gc::GcHeap::get().stats().minorCollections;
+    int64_t a = 0, b = 0;
+    std::thread other([&] { b = second.run(); });
+    a = first.run();
+    other.join();
+
+    EXPECT_EQ(a, int64_t{200000} * 200001 / 2);
+    EXPECT_EQ(b, int64_t{150000} * 150001 / 2);
+    EXPECT_GT(gc::GcHeap::get().stats().minorCollections, collections);
+}
+
+TEST(JitThreadsTest, SpinningLoopStopsForCollections)
+{
+    // The counting thread never allocates, so only its back-edge poll lets the other thread's
+    // collections go ahead; without it the allocating thread waits until the count is done.
+    JitProgram counter(
+        "གྲངས་ n = ༠;"
+        "ཡང་བསྐྱར་ (n < ༡༠༠༠༠༠༠༠༠༠) { n = n + ༡; }"
+        "སླར་ལོག་ n;");
+    JitProgram allocator(allocatingSum("c", "༡༠༠༠༠༠"));
+    ASSERT_NE(counter.entry, nullptr);
+    ASSERT_NE(allocator.entry, nullptr);
+
+    std::atomic<bool> started{false}, counted{false};
+    int64_t           n = 0;
+    std::thread       other(
+        [&]
+        {
+            started = true;
+            n       = counter.run();
+            counted = true;
+        });
+    while (!started) std::this_thread::yield();
+
+    size_t collections = gc::GcHeap::get().stats().minorCollections;
+    EXPECT_EQ(allocator.run(), int64_t{100000} * 100001 / 2);
+    EXPECT_GT(gc::GcHeap::get().stats().minorCollections, collections);
+    EXPECT_FALSE(counted);
+
+    other.join();
+    EXPECT_EQ(n, 1000000000);
+}
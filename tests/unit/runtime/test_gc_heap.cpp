@@ -0,0 +1,716 @@
+// test_gc_heap.cpp — druk::gc::GcHeap generational collection
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "druk/codegen/core/value.h"
+#include "druk/gc/gc_heap.h"
+#include "druk/gc/gc_layout.h"
+#include "druk/gc/types/gc_array.h"
+#include "druk/gc/types/gc_string.h"
+#include "druk/gc/types/gc_struct.h"
+
+
+using namespace druk::codegen;
+using namespace druk::gc;
+
+namespace
+{
+std::vector<GcObject*> g_test_roots;
+}
+
+class GcHeapTest : public ::testing::Test
+{
+   protected:
+    void SetUp() override
+    {
+        g_test_roots.clear();
+        roots_ = GcHeap::get().roots().addCallback(
+            [](void*)
+            {
+                for (auto* obj : g_test_roots) GcHeap::get().markObject(obj);
+            },
+            nullptr);
+        GcHeap::get().collect();
+    }
+
+    void TearDown() override
+    {
+        g_test_roots.clear();
+        roots_.reset();
+    }
+
+    GcRootHandle roots_;
+};
+
+// ─── Minor collections ────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, UnreachableYoungObjectsDie)
+{
+    auto&  heap   = GcHeap::get();
+    size_t before = heap.objectCount();
+    for (int i = 0; i < 10; ++i) heap.allocString("temp");
+    EXPECT_EQ(heap.objectCount(), before + 10);
+
+    heap.collectMinor();
+    EXPECT_EQ(heap.objectCount(), before);
+}
+
+TEST_F(GcHeapTest, RootedYoungObjectIsPromoted)
+{
+    auto& heap = GcHeap::get();
+    auto* str  = heap.allocString("kept");
+    EXPECT_TRUE(str->young);
+
+    g_test_roots.push_back(str);
+    heap.collectMinor();
+    EXPECT_FALSE(str->young);
+    EXPECT_EQ(str->view(), "kept");
+}
+
+TEST_F(GcHeapTest, MinorCollectionKeepsOldObjects)
+{
+    auto&  heap   = GcHeap::get();
+    size_t before = heap.objectCount();
+    g_test_roots.push_back(heap.alloc<GcArray>());
+    heap.collectMinor();
+
+    g_test_roots.clear();
+    heap.collectMinor();
+    EXPECT_EQ(heap.objectCount(), before + 1);
+
+    heap.collect();
+    EXPECT_EQ(heap.objectCount(), before);
+}
+
+// ─── Page allocator ───────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, FreedSlotIsReused)
+{
+    auto& heap = GcHeap::get();
+    auto* kept = heap.allocString("kept");
+    void* dead = heap.allocString("dead");
+    g_test_roots.push_back(kept);
+    heap.collect();
+
+    void* reused = heap.allocString("reused");
+    EXPECT_EQ(reused, dead);
+    EXPECT_EQ(GcPage::of(reused), GcPage::of(kept));
+}
+
+TEST_F(GcHeapTest, SizeClassesCoverObjectTypes)
+{
+    EXPECT_LT(sizeClassOf(sizeof(GcString)), kSizeClasses.size());
+    EXPECT_LT(sizeClassOf(sizeof(GcArray)), kSizeClasses.size());
+    EXPECT_EQ(sizeClassOf(1), 0u);
+    EXPECT_EQ(sizeClassOf(kSizeClasses.back() + 1), kSizeClasses.size());
+}
+
+TEST_F(GcHeapTest, ObjectHeaderHasNoVtable)
+{
+    EXPECT_FALSE(std::is_polymorphic_v<GcObject>);
+    EXPECT_LE(sizeof(GcObject), 4u);
+    // The header packs into the padding before the first payload member.
+    EXPECT_EQ(sizeof(GcArray), sizeof(GcArrayElements) + alignof(GcArrayElements));
+    EXPECT_EQ(sizeof(GcString), 4 + sizeof(uint32_t));
+}
+
+TEST_F(GcHeapTest, FullCollectionCountsDeadObjectsBeforeSweeping)
+{
+    auto&  heap   = GcHeap::get();
+    size_t before = heap.objectCount();
+    auto*  kept   = heap.allocString("kept");
+    g_test_roots.push_back(kept);
+    for (int i = 0; i < 1000; ++i) heap.allocString("dead");
+
+    heap.collect();
+    EXPECT_EQ(heap.objectCount(), before + 1);
+    // The allocator sweeps the page lazily and hands out one of the dead slots.
+    auto* reused = heap.allocString("reused");
+    EXPECT_EQ(GcPage::of(reused), GcPage::of(kept));
+    EXPECT_EQ(heap.objectCount(), before + 2);
+}
+
+TEST_F(GcHeapTest, BackgroundSweepFreesDeadObjects)
+{
+    auto&  heap   = GcHeap::get();
+    size_t before = heap.objectCount();
+    heap.setBackgroundSweep(true);
+    for (int i = 0; i < 10000; ++i) heap.allocString(std::string(64, 'x'));
+    heap.collect();
+    EXPECT_EQ(heap.objectCount(), before);
+    for (int i = 0; i < 1000; ++i) heap.allocString("more");
+    heap.collect();
+    heap.setBackgroundSweep(false);
+    EXPECT_EQ(heap.objectCount(), before);
+}
+
+// ─── Root handles ─────────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, RootHandleDropsItsRootWhenDestroyed)
+{
+    auto&     heap   = GcHeap::get();
+    size_t    before = heap.objectCount();
+    size_t    roots  = heap.roots().size();
+    GcObject* slot   = heap.allocString("rooted");
+    {
+        GcRootHandle handle = heap.roots().addSlots(&slot, 1);
+        EXPECT_EQ(heap.roots().size(), roots + 1);
+        heap.collect();
+        EXPECT_EQ(heap.objectCount(), before + 1);
+    }
+    EXPECT_EQ(heap.roots().size(), roots);
+    heap.collect();
+    EXPECT_EQ(heap.objectCount(), before);
+}
+
+TEST_F(GcHeapTest, StackRootTracesUpToCurrentTop)
+{
+    auto&  heap   = GcHeap::get();
+    size_t before = heap.objectCount();
+    Value  stack[4];
+    Value* top = stack;
+    auto   handle = heap.roots().addStack(stack, &top);
+
+    *top++ = Value(heap.allocString("live"));
+    *top++ = Value(heap.allocString("popped"));
+    heap.collect();
+    EXPECT_EQ(heap.objectCount(), before + 2);
+
+    --top;
+    heap.collect();
+    EXPECT_EQ(heap.objectCount(), before + 1);
+    EXPECT_EQ(stack[0].asString(), "live");
+}
+
+TEST_F(GcHeapTest, RootHandlesMoveAndRelease)
+{
+    auto&     heap  = GcHeap::get();
+    size_t    roots = heap.roots().size();
+    GcObject* slot  = nullptr;
+    auto      first = heap.roots().addSlots(&slot, 1);
+    first.reset();
+    auto second = heap.roots().addValues(nullptr, 0);
+    auto third  = std::move(second);
+    EXPECT_FALSE(second);
+    EXPECT_TRUE(third);
+    EXPECT_EQ(heap.roots().size(), roots + 1);
+}
+
+// ─── Byte accounting ──────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, PayloadBytesAreAccounted)
+{
+    auto&  heap   = GcHeap::get();
+    size_t before = heap.heapBytes();
+    heap.allocString(std::string(4096, 'x'));
+    EXPECT_GE(heap.heapBytes(), before + 4096);
+
+    auto* arr = heap.alloc<GcArray>();
+    for (int i = 0; i < 100; ++i) arr->elements.push_back(Value(int64_t{i}));
+    EXPECT_GE(payloadBytes(arr), 100 * sizeof(Value));
+}
+
+// ─── Statistics ───────────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, StatsCountCollectionsAndLiveObjectsByType)
+{
+    auto&   heap  = GcHeap::get();
+    GcStats start = heap.stats();
+    auto*   arr   = heap.alloc<GcArray>();
+    g_test_roots.push_back(arr);
+    for (int i = 0; i < 3; ++i)
+    {
+        auto* str = heap.allocString("kept");
+        arr->elements.push_back(Value(str));
+        heap.writeBarrier(arr, str);
+    }
+    for (int i = 0; i < 100; ++i) heap.allocString("dead");
+    heap.collect();
+
+    GcStats stats = heap.stats();
+    EXPECT_EQ(stats.fullCollections, start.fullCollections + 1);
+    EXPECT_GE(stats.pauses, start.pauses + 1);
+    EXPECT_GE(stats.objectsFreed, start.objectsFreed + 100);
+    EXPECT_GE(stats.bytesAllocated, start.bytesAllocated + 104 * 32);
+    EXPECT_GT(stats.bytesFreed, start.bytesFreed);
+    EXPECT_EQ(stats.liveObjectsByType[static_cast<size_t>(GcType::String)],
+              start.liveObjectsByType[static_cast<size_t>(GcType::String)] + 3);
+    EXPECT_EQ(stats.liveObjectsByType[static_cast<size_t>(GcType::Array)],
+              start.liveObjectsByType[static_cast<size_t>(GcType::Array)] + 1);
+    EXPECT_EQ(stats.liveObjects, heap.objectCount());
+}
+
+TEST_F(GcHeapTest, HeapProfileGroupsLiveObjectsBySite)
+{
+    auto& heap = GcHeap::get();
+    heap.setHeapProfile(1);
+    uint32_t site = heap.profile().addSite("main:7");
+    heap.profile().setSite(site);
+    auto* arr = heap.alloc<GcArray>();
+    g_test_roots.push_back(arr);
+    for (int i = 0; i < 2; ++i)
+    {
+        auto* str = heap.allocString("kept");
+        arr->elements.push_back(Value(str));
+        heap.writeBarrier(arr, str);
+    }
+    for (int i = 0; i < 50; ++i) heap.allocString("dead");
+    heap.profile().setSite(0);
+    heap.collect();
+
+    std::ostringstream out;
+    heap.printHeapProfile(out, "in test");
+    heap.setHeapProfile(0);
+    std::string report = out.str();
+    EXPECT_NE(report.find("Heap profile in test"), std::string::npos);
+    EXPECT_NE(report.find("3 objects  main:7 (array 1, string 2)"), std::string::npos) << report;
+}
+
+// ─── Inline payloads ──────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, StringBytesLiveInTheObject)
+{
+    auto& heap = GcHeap::get();
+    auto* str  = heap.allocString("con", "cat");
+    EXPECT_EQ(str->view(), "concat");
+    EXPECT_EQ(str->chars()[str->length()], '\0');
+    EXPECT_EQ(str->chars(), reinterpret_cast<const char*>(str + 1));
+    EXPECT_EQ(payloadBytes(str), 0u);
+}
+
+TEST_F(GcHeapTest, LargeStringGetsItsOwnPageAndIsFreed)
+{
+    auto&       heap   = GcHeap::get();
+    size_t      before = heap.objectCount();
+    std::string text(100000, 'y');
+    auto*       str = heap.allocString(text);
+    g_test_roots.push_back(str);
+    heap.collect();
+    EXPECT_EQ(str->view(), text);
+    EXPECT_EQ(heap.objectCount(), before + 1);
+
+    g_test_roots.clear();
+    heap.collect();
+    EXPECT_EQ(heap.objectCount(), before);
+}
+
+TEST_F(GcHeapTest, ArrayElementsSpillPastInlineCapacity)
+{
+    auto& heap = GcHeap::get();
+    auto* arr  = heap.alloc<GcArray>();
+    g_test_roots.push_back(arr);
+    for (size_t i = 0; i < GcArrayElements::kInlineCapacity; ++i)
+        arr->elements.push_back(Value(static_cast<int64_t>(i)));
+    EXPECT_FALSE(arr->elements.spilled());
+    EXPECT_EQ(payloadBytes(arr), 0u);
+
+    for (size_t i = GcArrayElements::kInlineCapacity; i < 50; ++i)
+    {
+        auto* str = heap.allocString(std::to_string(i));
+        arr->elements.push_back(Value(str));
+        heap.writeBarrier(arr, str);
+    }
+    EXPECT_TRUE(arr->elements.spilled());
+    heap.collect();
+    EXPECT_EQ(arr->elements[3].asInt(), 3);
+    EXPECT_EQ(arr->elements[49].asString(), "49");
+}
+
+TEST_F(GcHeapTest, ArrayPushesItsOwnElementWhileFull)
+{
+    auto& heap = GcHeap::get();
+    auto* arr  = heap.alloc<GcArray>();
+    g_test_roots.push_back(arr);
+    arr->elements.push_back(Value(static_cast<int64_t>(7)));
+    // Full in place first, then full in each buffer it spills to, which growing frees.
+    while (arr->elements.size() < 40) arr->elements.push_back(arr->elements[0]);
+    EXPECT_TRUE(arr->elements.spilled());
+    for (const auto& element : arr->elements) EXPECT_EQ(element.asInt(), 7);
+}
+
+TEST_F(GcHeapTest, StructsWithTheSameFieldsShareAShape)
+{
+    auto& heap = GcHeap::get();
+    auto* a    = heap.alloc<GcStruct>();
+    auto* b    = heap.alloc<GcStruct>();
+    auto* c    = heap.alloc<GcStruct>();
+    g_test_roots.insert(g_test_roots.end(), {a, b, c});
+    a->set("x", Value(static_cast<int64_t>(1)));
+    a->set("y", Value(static_cast<int64_t>(2)));
+    b->set("x", Value(static_cast<int64_t>(3)));
+    b->set("y", Value(static_cast<int64_t>(4)));
+    c->set("y", Value(static_cast<int64_t>(5)));
+    c->set("x", Value(static_cast<int64_t>(6)));
+
+    EXPECT_EQ(a->shape, b->shape);
+    EXPECT_NE(a->shape, c->shape);
+    EXPECT_EQ(a->shape, GcShape::empty()->with("x")->with("y"));
+    EXPECT_EQ(a->shape->slotOf("y"), 1u);
+    EXPECT_EQ(c->shape->slotOf("y"), 0u);
+    EXPECT_EQ(a->shape->slotOf("z"), GcShape::kNoSlot);
+
+    // Overwriting a field keeps the shape; adding one moves on to the next.
+    const GcShape* shape = b->shape;
+    b->set("x", Value(static_cast<int64_t>(7)));
+    EXPECT_EQ(b->shape, shape);
+    for (int i = 0; i < 10; ++i)
+    {
+        auto* str = heap.allocString(std::to_string(i));
+        b->set("f" + std::to_string(i), Value(str));
+        heap.writeBarrier(b, str);
+    }
+    EXPECT_EQ(b->size(), 12u);
+    EXPECT_TRUE(b->fields.spilled());
+
+    heap.collect();
+    EXPECT_EQ(b->find("x")->asInt(), 7);
+    EXPECT_EQ(b->find("f9")->asString(), "9");
+    EXPECT_EQ(c->find("x")->asInt(), 6);
+    EXPECT_EQ(a->find("z"), nullptr);
+}
+
+TEST_F(GcHeapTest, LargePayloadTriggersMinorCollection)
+{
+    auto&  heap   = GcHeap::get();
+    size_t before = heap.objectCount();
+    heap.allocString(std::string(kNurseryBytes, 'x'));
+    EXPECT_EQ(heap.objectCount(), before + 1);
+
+    // The nursery budget is spent by one object, so the next allocation collects it.
+    heap.allocString("next");
+    EXPECT_EQ(heap.objectCount(), before + 1);
+}
+
+// ─── Write barrier ────────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, WriteBarrierKeepsYoungChildOfOldObject)
+{
+    auto& heap = GcHeap::get();
+    auto* arr  = heap.alloc<GcArray>();
+    g_test_roots.push_back(arr);
+    heap.collectMinor();
+    ASSERT_FALSE(arr->young);
+
+    auto* child = heap.allocString("child");
+    arr->elements.push_back(Value(child));
+    heap.writeBarrier(arr, child);
+    EXPECT_TRUE(arr->remembered);
+
+    heap.collectMinor();
+    EXPECT_FALSE(arr->remembered);
+    EXPECT_FALSE(child->young);
+    EXPECT_EQ(child->view(), "child");
+}
+
+TEST_F(GcHeapTest, WriteBarrierIgnoresYoungOwner)
+{
+    auto& heap  = GcHeap::get();
+    auto* arr   = heap.alloc<GcArray>();
+    auto* child = heap.allocString("child");
+    heap.writeBarrier(arr, child);
+    EXPECT_FALSE(arr->remembered);
+}
+
+// ─── Parallel marking ─────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, ParallelMarkKeepsReachableGraph)
+{
+    auto&  heap   = GcHeap::get();
+    size_t before = heap.objectCount();
+    auto*  top    = heap.alloc<GcArray>();
+    g_test_roots.push_back(top);
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto* node = heap.alloc<GcStruct>();
+        top->elements.push_back(Value(node));
+        heap.writeBarrier(top, node);
+        auto* str = heap.allocString(std::to_string(i));
+        node->set("s", Value(str));
+        heap.writeBarrier(node, str);
+        heap.allocString("garbage");
+    }
+
+    heap.setMarkThreads(4);
+    heap.collect();
+    heap.setMarkThreads(1);
+    EXPECT_EQ(heap.objectCount(), before + 2001);
+    auto* last = static_cast<GcStruct*>(top->elements.back().gcRef());
+    EXPECT_EQ(static_cast<GcString*>(last->find("s")->gcRef())->view(), "999");
+}
+
+// ─── Incremental marking ──────────────────────────────────────────────────────
+TEST_F(GcHeapTest, WriteBarrierShadesChildStoredDuringIncrementalMark)
+{
+    auto&  heap   = GcHeap::get();
+    size_t before = heap.objectCount();
+    auto*  wide   = heap.alloc<GcArray>();
+    g_test_roots.push_back(wide);
+    for (int i = 0; i < 500; ++i)
+    {
+        auto* elem = heap.alloc<GcArray>();
+        wide->elements.push_back(Value(elem));
+        heap.writeBarrier(wide, elem);
+    }
+    // Rooted last, so the first step traces it before running out of budget on `wide`.
+    auto* arr = heap.alloc<GcArray>();
+    g_test_roots.push_back(arr);
+
+    heap.setPauseBudget(0);
+    heap.markIncrement();
+    ASSERT_TRUE(heap.marking());
+
+    auto* child = heap.allocString("child");
+    arr->elements.push_back(Value(child));
+    heap.writeBarrier(arr, child);
+
+    heap.collect();
+    EXPECT_FALSE(heap.marking());
+    EXPECT_EQ(heap.objectCount(), before + 503);
+    EXPECT_EQ(child->view(), "child");
+}
+
+TEST_F(GcHeapTest, PauseHistogramCountsOutermostPauses)
+{
+    auto& heap = GcHeap::get();
+    heap.pauses().reset();
+    heap.collectMinor();
+    heap.collect();
+    EXPECT_EQ(heap.pauses().count(), 2u);
+
+    GcPauseHistogram histogram;
+    histogram.record(std::chrono::nanoseconds(500));
+    histogram.record(std::chrono::microseconds(3));
+    EXPECT_EQ(histogram.bucket(0), 1u);
+    EXPECT_EQ(histogram.bucket(2), 1u);
+    EXPECT_EQ(histogram.max(), std::chrono::microseconds(3));
+}
+
+// ─── Compaction ───────────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, CompactionSlidesSurvivorsAndUpdatesReferences)
+{
+    auto&              heap = GcHeap::get();
+    std::vector<Value> kept;
+    kept.reserve(3000);
+    auto roots = heap.roots().addValues(kept.data(), 0);
+    for (int i = 0; i < 20000; ++i)
+    {
+        auto* str = heap.allocString("s" + std::to_string(i));
+        if (i % 10 == 0)
+        {
+            kept.push_back(Value(str));
+            roots.update(kept.data(), kept.size());
+        }
+    }
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto* arr   = heap.alloc<GcArray>();
+        auto* struc = heap.alloc<GcStruct>();
+        if (i % 10 != 0)
+            continue;
+        struc->set("first", kept[0]);
+        for (int e = 0; e < (i % 20 ? 6 : 2); ++e) arr->elements.push_back(kept[1]);
+        kept.push_back(Value(arr));
+        kept.push_back(Value(struc));
+        roots.update(kept.data(), kept.size());
+    }
+    GcObject* slot     = kept[2].gcRef();
+    auto      slotRoot = heap.roots().addSlots(&slot, 1);
+
+    heap.collect();
+    size_t  fragmented = heap.fragmentation();
+    size_t  objects    = heap.objectCount();
+    GcStats before     = heap.stats();
+    EXPECT_GT(fragmented, 50u);
+
+    heap.compact();
+    GcStats after = heap.stats();
+    EXPECT_EQ(after.compactions, before.compactions + 1);
+    EXPECT_GT(after.objectsMoved, before.objectsMoved);
+    EXPECT_LT(after.committedBytes, before.committedBytes);
+    EXPECT_LT(heap.fragmentation(), fragmented);
+    EXPECT_EQ(heap.objectCount(), objects);
+
+    for (size_t i = 0; i < 2000; ++i) EXPECT_EQ(kept[i].asString(), "s" + std::to_string(i * 10));
+    EXPECT_EQ(slot, kept[2].gcRef());
+    for (size_t i = 2000; i < kept.size(); i += 2)
+    {
+        auto* arr = kept[i].asGcArray();
+        ASSERT_GE(arr->elements.size(), 2u);
+        for (const Value& elem : arr->elements) EXPECT_EQ(elem.asString(), "s10");
+        EXPECT_EQ(kept[i + 1].asGcStruct()->find("first")->asString(), "s0");
+    }
+}
+
+TEST_F(GcHeapTest, FragmentationSchedulesCompactionAndCallbackRootsPin)
+{
+    auto&                  heap   = GcHeap::get();
+    GcString*              pinned = nullptr;
+    std::vector<GcObject*> kept;
+    for (int i = 0; i < 20000; ++i)
+    {
+        auto* str = heap.allocString("garbage");
+        if (i % 20 == 0)
+            kept.push_back(str);
+        if (i == 10000)
+        {
+            // Past slots that die, so it would slide if the callback root did not pin it.
+            pinned = heap.allocString("pinned");
+            g_test_roots.push_back(pinned);
+        }
+    }
+    auto roots = heap.roots().addSlots(kept.data(), kept.size());
+
+    size_t compactions = heap.stats().compactions;
+    heap.setCompactThreshold(50);
+    heap.collect();
+    heap.setCompactThreshold(0);
+    EXPECT_EQ(heap.stats().compactions, compactions);
+
+    heap.safepoint();
+    EXPECT_EQ(heap.stats().compactions, compactions + 1);
+    EXPECT_EQ(g_test_roots[0], pinned);
+    EXPECT_EQ(pinned->view(), "pinned");
+    for (GcObject* obj : kept) EXPECT_EQ(static_cast<GcString*>(obj)->view(), "garbage");
+
+    heap.safepoint();
+    EXPECT_EQ(heap.stats().compactions, compactions + 1);
+}
+
+// ─── Mutator threads ──────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, MutatorThreadsAllocateAndCollectConcurrently)
+{
+    constexpr int kThreads = 4;
+    constexpr int kRounds  = 20000;
+
+    auto&            heap   = GcHeap::get();
+    size_t           before = heap.objectCount();
+    std::atomic<int> corrupted{0};
+    auto             run    = [&](int thread)
+    {
+        GcMutatorScope     mutator;
+        std::vector<Value> kept(64);
+        auto               roots  = heap.roots().addValues(kept.data(), kept.size());
+        std::string        prefix = std::to_string(thread) + ":";
+        for (size_t i = 0; i < kRounds; ++i)
+        {
+            auto* arr             = heap.alloc<GcArray>();
+            kept[i % kept.size()] = Value(arr);  // rooted before the next allocation
+            auto* str             = heap.allocString(prefix, std::to_string(i));
+            arr->elements.push_back(Value(str));
+            heap.writeBarrier(arr, str);
+            if (i % 5000 == 4999)
+                heap.collect();
+            heap.safepoint();
+
+            const Value& older = kept[(i + 1) % kept.size()];
+            if (older.isArray() && !older.asGcArray()->elements[0].asString().starts_with(prefix))
+                ++corrupted;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) threads.emplace_back(run, t);
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(corrupted.load(), 0);
+    EXPECT_GT(heap.stats().minorCollections, 0u);
+    heap.collect();
+    EXPECT_EQ(heap.objectCount(), before);
+}
+
+TEST_F(GcHeapTest, NativeScopeLetsOtherThreadsCollect)
+{
+    auto&          heap = GcHeap::get();
+    GcMutatorScope mutator;
+    size_t         collections = heap.stats().fullCollections;
+    {
+        // A running thread that blocks without leaving the heap would stall this collection.
+        GcNativeScope blocking;
+        std::thread([&] { heap.collect(); }).join();
+    }
+    EXPECT_EQ(heap.stats().fullCollections, collections + 1);
+}
+
+// ─── Inline allocation ────────────────────────────────────────────────────────
+namespace
+{
+
+// What JIT-compiled code emits for a one-element array literal: bump the thread's buffer and
+// write the object through GcObjectLayout. Null when the buffer is dry.
+GcArray* bumpArray(int64_t element)
+{
+    GcAllocationBuffer& buffer = GcHeap::get().allocationBuffer();
+    size_t              cls    = sizeClassOf(sizeof(GcArray));
+    size_t              slot   = kSizeClasses[cls];
+    GcBumpRun&          run    = buffer.runs[cls];
+    if (buffer.budget < slot || static_cast<size_t>(run.limit - run.cursor) < slot)
+        return nullptr;
+    std::byte* obj = run.cursor;
+    run.cursor += slot;
+    buffer.budget -= slot;
+
+    const GcObjectLayout& layout  = GcObjectLayout::get();
+    std::byte*            storage = obj + layout.arrayInline;
+    size_t                size    = 1;
+    size_t                cap     = GcArrayElements::kInlineCapacity;
+    Value                 value(element);
+    obj[layout.young]      = std::byte{1};
+    obj[layout.remembered] = std::byte{0};
+    obj[layout.kind]       = static_cast<std::byte>(GcType::Array);
+    obj[layout.immortal]   = std::byte{0};
+    std::memcpy(obj + layout.arrayData, &storage, sizeof(storage));
+    std::memcpy(obj + layout.arraySize, &size, sizeof(size));
+    std::memcpy(obj + layout.arrayCapacity, &cap, sizeof(cap));
+    std::memcpy(storage, &value, sizeof(value));
+    return reinterpret_cast<GcArray*>(obj);
+}
+
+}  // namespace
+
+TEST_F(GcHeapTest, BumpedObjectsAreCountedAndCollected)
+{
+    auto&          heap = GcHeap::get();
+    GcMutatorScope mutator;
+    size_t         before = heap.objectCount();
+
+    GcArray* arr;
+    while (!(arr = bumpArray(0)))
+        heap.alloc<GcArray>();  // until the thread owns a page with never-used slots
+    g_test_roots.push_back(arr);
+    for (int64_t i = 1; i < 100 && (arr = bumpArray(i)); ++i)
+        if (i % 10 == 0)
+            g_test_roots.push_back(arr);
+    ASSERT_GT(g_test_roots.size(), 1u);
+
+    heap.collect();
+    EXPECT_EQ(heap.objectCount(), before + g_test_roots.size());
+    for (size_t i = 0; i < g_test_roots.size(); ++i)
+    {
+        arr = static_cast<GcArray*>(g_test_roots[i]);
+        EXPECT_FALSE(arr->young);
+        ASSERT_EQ(arr->elements.size(), 1u);
+        EXPECT_EQ(arr->elements[0].asInt(), static_cast<int64_t>(i * 10));
+    }
+}
+
+// ─── Immortal objects ─────────────────────────────────────────────────────────
+TEST_F(GcHeapTest, ImmortalStringIsTracedPastButNeverTouched)
+{
+    auto&       heap   = GcHeap::get();
+    std::string image  = immortalStringImage("literal");
+    auto*       str    = reinterpret_cast<GcString*>(image.data());
+    size_t      before = heap.objectCount();
+    EXPECT_EQ(str->view(), "literal");
+
+    auto* arr = heap.alloc<GcArray>();
+    g_test_roots.push_back(arr);
+    heap.collect();
+    arr->elements.push_back(Value(str));
+    heap.writeBarrier(arr, str);
+    heap.collectMinor();
+    heap.compact();
+
+    EXPECT_EQ(heap.objectCount(), before + 1);
+    EXPECT_EQ(arr->elements[0].asGcString(), str);
+    EXPECT_EQ(image, immortalStringImage("literal"));  // no header bit written
+}
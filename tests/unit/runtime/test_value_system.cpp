@@ -1,6 +1,10 @@
 // test_value_system.cpp — druk::codegen::Value type safety and operations
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <cstring>
+#include <new>
+
 #include "druk/codegen/core/value.h"
 
 
@@ -60,6 +64,19 @@ TEST_F(ValueSystemTest, FalseValue)
     EXPECT_TRUE(v.isBool());
     EXPECT_FALSE(v.asBool());
 }
+TEST_F(ValueSystemTest, BoolFillsWholePayload)
+{
+    // Compiled code copies a value's raw bytes and reads a bool's payload as an int64.
+    alignas(Value) unsigned char bytes[sizeof(Value)];
+    for (bool b : {false, true})
+    {
+        std::memset(bytes, 0xff, sizeof(bytes));
+        new (bytes) Value(b);
+        int64_t payload = -1;
+        std::memcpy(&payload, bytes + sizeof(Value) - sizeof(payload), sizeof(payload));
+        EXPECT_EQ(payload, b ? 1 : 0);
+    }
+}
 
 // ─── Equality ─────────────────────────────────────────────────────────────────
 TEST_F(ValueSystemTest, IntEquality)
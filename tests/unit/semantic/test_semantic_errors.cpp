@@ -57,6 +57,14 @@ TEST_F(SemanticErrorsTest, CallUndeclaredFunction)
     EXPECT_FALSE(ok);
 }
 
+// ─── Struct literals ─────────────────────────────────────────────────────────
+
+TEST_F(SemanticErrorsTest, DuplicateStructFieldFails)
+{
+    EXPECT_TRUE(sh.analyze("བཀོད་ {x: ༡, y: ༢}.y;"));
+    EXPECT_FALSE(sh.analyze("བཀོད་ {x: ༡, x: ༢}.x;"));
+}
+
 // ─── Error state on malformed source ─────────────────────────────────────────
 
 TEST_F(SemanticErrorsTest, ParseErrorPreventsSemantic)
@@ -57,3 +57,15 @@ TEST_F(TypeCheckerTest, SimpleFunctionValid)
 {
     EXPECT_TRUE(sh.analyze("ལས་འགན་ square(གྲངས་ n) { སླར་ལོག་ n * n; }"));
 }
+
+TEST_F(TypeCheckerTest, BinaryExpressionTypeIsRecorded)
+{
+    std::string_view         src = "གྲངས་ x = ༡ + ༢;";
+    druk::parser::Parser     parser(src, sh.arena, sh.interner, sh.errors);
+    auto                     stmts = parser.parse();
+    druk::semantic::Analyzer analyzer(sh.errors, sh.interner, src);
+    ASSERT_TRUE(analyzer.analyze(stmts));
+
+    auto* decl = static_cast<druk::parser::ast::VarDecl*>(stmts[0]);
+    EXPECT_EQ(decl->initializer->type, druk::semantic::Type::makeInt());
+}
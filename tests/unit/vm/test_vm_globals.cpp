@@ -0,0 +1,224 @@
+// test_vm_globals.cpp — druk::vm::VM global variables, stored by slot
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "druk/codegen/core/global_slots.h"
+#include "druk/codegen/core/obj.h"
+#include "druk/codegen/core/opcode.h"
+#include "druk/gc/gc_heap.h"
+#include "druk/vm/vm.hpp"
+
+
+using namespace druk;
+using namespace druk::codegen;
+
+namespace druk::vm
+{
+
+// Declared a friend by VM, so tests can see how far the globals have grown.
+class VMTest : public ::testing::Test
+{
+   protected:
+    VM machine;
+
+    size_t globalCount() const
+    {
+        return machine.globals_.size();
+    }
+};
+
+}  // namespace druk::vm
+
+using druk::vm::VMTest;
+
+namespace
+{
+
+// Writes a function's bytecode by hand, the way the compiler would; function() finishes it.
+struct Script
+{
+    ObjFunction fn;
+
+    ObjFunction* function()
+    {
+        fn.chunk.resolveGlobals();
+        return &fn;
+    }
+
+    int name(std::string_view text)
+    {
+        return fn.chunk.addConstant(Value(gc::GcHeap::get().allocString(text)));
+    }
+    int number(int64_t n)
+    {
+        return fn.chunk.addConstant(Value(n));
+    }
+    void op(OpCode opcode)
+    {
+        fn.chunk.write(opcode, 1);
+    }
+    void op(OpCode opcode, int operand)
+    {
+        fn.chunk.write(opcode, 1);
+        fn.chunk.write(static_cast<uint8_t>(operand), 1);
+    }
+};
+
+}  // namespace
+
+// ─── Define / get / set ───────────────────────────────────────────────────────
+
+TEST_F(VMTest, DefineGetAndSet)
+{
+    Script s;
+    int    x = s.name("vm_round_trip");
+    s.op(OpCode::Constant, s.number(5));
+    s.op(OpCode::DefineGlobal, x);
+    s.op(OpCode::Constant, s.number(7));
+    s.op(OpCode::SetGlobal, x);
+    s.op(OpCode::Pop);
+    s.op(OpCode::GetGlobal, x);
+    s.op(OpCode::Return);
+
+    ASSERT_EQ(machine.interpret(s.function()), InterpretResult::Ok);
+    EXPECT_EQ(machine.lastResult().asInt(), 7);
+}
+
+TEST_F(VMTest, RedefineReplacesValue)
+{
+    Script s;
+    int    x = s.name("vm_redefined");
+    s.op(OpCode::Constant, s.number(1));
+    s.op(OpCode::DefineGlobal, x);
+    s.op(OpCode::Constant, s.number(2));
+    s.op(OpCode::DefineGlobal, x);
+    s.op(OpCode::GetGlobal, x);
+    s.op(OpCode::Return);
+
+    ASSERT_EQ(machine.interpret(s.function()), InterpretResult::Ok);
+    EXPECT_EQ(machine.lastResult().asInt(), 2);
+}
+
+// ─── Undefined names ──────────────────────────────────────────────────────────
+
+TEST_F(VMTest, GetUndefinedIsRuntimeError)
+{
+    Script s;
+    s.op(OpCode::GetGlobal, s.name("vm_never_defined_get"));
+    s.op(OpCode::Return);
+
+    testing::internal::CaptureStderr();
+    EXPECT_EQ(machine.interpret(s.function()), InterpretResult::RuntimeError);
+    EXPECT_NE(testing::internal::GetCapturedStderr().find(
+                  "Undefined variable 'vm_never_defined_get'"),
+              std::string::npos);
+}
+
+TEST_F(VMTest, SetUndefinedIsRuntimeError)
+{
+    Script s;
+    s.op(OpCode::Constant, s.number(1));
+    s.op(OpCode::SetGlobal, s.name("vm_never_defined_set"));
+    s.op(OpCode::Return);
+
+    testing::internal::CaptureStderr();
+    EXPECT_EQ(machine.interpret(s.function()), InterpretResult::RuntimeError);
+    EXPECT_NE(testing::internal::GetCapturedStderr().find(
+                  "Undefined variable 'vm_never_defined_set'"),
+              std::string::npos);
+}
+
+TEST_F(VMTest, UndefinedLookupsDoNotGrowGlobals)
+{
+    // Defining a name first gives the table some length; the name looked up afterwards is
+    // numbered after it, so it reaches past the end.
+    Script s;
+    s.op(OpCode::Constant, s.number(1));
+    s.op(OpCode::DefineGlobal, s.name("vm_before_the_end"));
+    s.op(OpCode::GetGlobal, s.name("vm_past_the_end"));
+    s.op(OpCode::Return);
+
+    testing::internal::CaptureStderr();
+    EXPECT_EQ(machine.interpret(s.function()), InterpretResult::RuntimeError);
+    testing::internal::GetCapturedStderr();
+    EXPECT_LE(globalCount(), globalSlot("vm_past_the_end"));
+}
+
+// ─── Slots shared across chunks ───────────────────────────────────────────────
+
+TEST_F(VMTest, ChunksResolveNameToSameSlot)
+{
+    // The name sits at a different constant index in each chunk.
+    Script definer, reader;
+    int    defined = definer.name("vm_shared");
+    reader.number(0);
+    int read = reader.name("vm_shared");
+    ASSERT_NE(defined, read);
+
+    definer.op(OpCode::Constant, definer.number(42));
+    definer.op(OpCode::DefineGlobal, defined);
+    definer.op(OpCode::Constant, definer.number(0));
+    definer.op(OpCode::Return);
+    reader.op(OpCode::GetGlobal, read);
+    reader.op(OpCode::Return);
+    ObjFunction* define = definer.function();
+    ObjFunction* get    = reader.function();
+
+    EXPECT_EQ(define->chunk.globalSlotAt(static_cast<size_t>(defined)),
+              get->chunk.globalSlotAt(static_cast<size_t>(read)));
+    EXPECT_EQ(get->chunk.globalSlotAt(static_cast<size_t>(read)), globalSlot("vm_shared"));
+
+    ASSERT_EQ(machine.interpret(define), InterpretResult::Ok);
+    ASSERT_EQ(machine.interpret(get), InterpretResult::Ok);
+    EXPECT_EQ(machine.lastResult().asInt(), 42);
+}
+
+TEST_F(VMTest, ResolvingNumbersOnlyGlobalNames)
+{
+    // A string that is only ever pushed names no global.
+    Script s;
+    int    text = s.name("vm_just_text");
+    int    x    = s.name("vm_resolved");
+    s.op(OpCode::Constant, text);
+    s.op(OpCode::DefineGlobal, x);
+    s.op(OpCode::Constant, s.number(0));
+    s.op(OpCode::Return);
+    ObjFunction* fn = s.function();
+
+    EXPECT_EQ(fn->chunk.globalSlotAt(static_cast<size_t>(text)), Chunk::kUnresolvedSlot);
+    EXPECT_EQ(fn->chunk.globalSlotAt(static_cast<size_t>(x)), globalSlot("vm_resolved"));
+}
+
+TEST_F(VMTest, ThreadsInterpretTheSameFunction)
+{
+    // Each thread runs its own VM over one chunk, which they only read.
+    Script s;
+    int    x = s.name("vm_per_thread");
+    s.op(OpCode::Constant, s.number(3));
+    s.op(OpCode::DefineGlobal, x);
+    s.op(OpCode::GetGlobal, x);
+    s.op(OpCode::Return);
+    ObjFunction* fn = s.function();
+
+    int64_t     other = 0;
+    std::thread thread(
+        [&]
+        {
+            druk::vm::VM vm;
+            for (int i = 0; i < 1000; ++i)
+                if (vm.interpret(fn) == InterpretResult::Ok)
+                    other += vm.lastResult().asInt();
+        });
+    int64_t mine = 0;
+    for (int i = 0; i < 1000; ++i)
+        if (machine.interpret(fn) == InterpretResult::Ok)
+            mine += machine.lastResult().asInt();
+    thread.join();
+
+    EXPECT_EQ(mine, 3000);
+    EXPECT_EQ(other, 3000);
+}